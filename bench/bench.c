@@ -0,0 +1,295 @@
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// Benchmark the example grammars on generated inputs from 1KB up to 1GB:
+//
+//   > cc -O2 bench/bench.c -o bench
+//   > ./bench          # inputs up to 32MB
+//   > ./bench 1G json  # inputs up to 1GB, json only
+//
+// grammars: json, uri, arith (examples/) and peg (the pPEG grammar).
+// The inputs are made from a fixed seed, so each run parses the same text.
+// One JSON line for each grammar and size, each is run in a new process:
+//
+//   {"grammar":"json","bytes":1024,"mb_s":..,"nodes_s":..,"nodes":..,
+//    "allocs_mb":..,"peak_rss_kb":..,"compile_us":..}
+//
+// allocs_mb is the malloc, calloc and realloc calls in one parse for each
+// MB of input, peak_rss_kb is the process peak (the input is included).
+
+long allocs = 0;
+
+static void* count_malloc(size_t n) {
+    allocs++;
+    return malloc(n);
+}
+
+static void* count_calloc(size_t n, size_t m) {
+    allocs++;
+    return calloc(n, m);
+}
+
+static void* count_realloc(void* p, size_t n) {
+    allocs++;
+    return realloc(p, n);
+}
+
+#define malloc(n) count_malloc(n)
+#define calloc(n, m) count_calloc(n, m)
+#define realloc(p, n) count_realloc(p, n)
+#include "../pPEG.c"
+#undef malloc
+#undef calloc
+#undef realloc
+
+char* json_grammar =
+"    json   = _ value _                                  \n"
+"    value  =  Str / Arr / Obj / num / lit               \n"
+"    Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+"    memb   = Str _':'_ value                            \n"
+"    Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+"    Str    = _DQ chars* _DQ                             \n"
+"    chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+"    esc    = [/bfnrt] / _DQ / _BS / 'u' [0-9a-fA-F]*4   \n"
+"    num    = _int _frac? _exp?                          \n"
+"    _int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+"    _frac  = '.' [0-9]+                                 \n"
+"    _exp   = [eE] [+-]? [0-9]+                          \n"
+"    lit    = 'true' / 'false' / 'null'                  \n";
+
+char* uri_grammar =
+"    URI     = (scheme ':')? ('//' auth)? path  \n"
+"              ('?' query)? ('#' frag)?         \n"
+"    scheme  = ~[:/?#]+                         \n"
+"    auth    = ~[/?#]*                          \n"
+"    path    = ~[?#]*                           \n"
+"    query   = ~'#'*                            \n"
+"    frag    = ~_WS*                            \n";
+
+char* arith_grammar =
+"add   = mult ('+' mult)*   \n"
+"mult  = int ('*' int)*     \n"
+"int   = [0-9]+             \n";
+
+// -- inputs ---------------------------------------------------------
+
+unsigned long long seed = 88172645463325252ULL;
+
+unsigned rnd(int n) { // xorshift, 0..n-1
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return (unsigned)(seed % n);
+}
+
+typedef struct {
+    char* s;
+    long len;
+    long max;
+} Text;
+
+void put(Text* t, char* str) {
+    long n = strlen(str);
+    if (t->len+n < t->max) memcpy(t->s+t->len, str, n);
+    t->len += n;
+}
+
+char* words[] = { "alpha", "beta", "gamma", "delta", "id", "name", "value", "list" };
+
+void json_value(Text* t, int depth) {
+    char buf[64];
+    int k = depth > 3? rnd(4) : rnd(6);
+    switch (k) {
+    case 0: sprintf(buf, "%d", (int)rnd(100000)-50000); put(t, buf); break;
+    case 1: sprintf(buf, "%d.%de%d", rnd(1000), rnd(100), rnd(20)); put(t, buf); break;
+    case 2: {
+        put(t, "\"");
+        put(t, words[rnd(8)]);
+        put(t, rnd(4)? " " : "\\n\\u00e9 ");
+        put(t, words[rnd(8)]);
+        put(t, "\"");
+        break;
+    }
+    case 3: put(t, rnd(3) == 0? "null" : rnd(2)? "true" : "false"); break;
+    case 4: {
+        int n = rnd(6);
+        put(t, "[");
+        for (int i=0; i<n; i++) {
+            if (i) put(t, ", ");
+            json_value(t, depth+1);
+        }
+        put(t, "]");
+        break;
+    }
+    default: {
+        int n = rnd(6);
+        put(t, "{");
+        for (int i=0; i<n; i++) {
+            sprintf(buf, "%s\"%s%d\": ", i? ", " : "", words[rnd(8)], i);
+            put(t, buf);
+            json_value(t, depth+1);
+        }
+        put(t, "}");
+    }
+    }
+}
+
+void json_input(Text* t) {
+    put(t, "[\n");
+    for (int i=0; ; i++) {
+        long len = t->len;
+        if (i) put(t, ",\n");
+        json_value(t, 2); // an object or list of scalars and lists
+        if (t->len > t->max-3) { // drop the value that does not fit
+            t->len = len;
+            break;
+        }
+    }
+    put(t, "\n]\n");
+}
+
+void uri_input(Text* t) {
+    put(t, "https://www.example.com:8080");
+    while (t->len < t->max*3/4) {
+        put(t, "/");
+        put(t, words[rnd(8)]);
+    }
+    put(t, "?");
+    while (t->len < t->max-100) {
+        put(t, words[rnd(8)]);
+        put(t, rnd(2)? "=1&" : "=x&");
+    }
+    put(t, "#frag");
+}
+
+void arith_input(Text* t) {
+    char buf[32];
+    for (int i=0; t->len < t->max-32; i++) {
+        sprintf(buf, "%s%d", i == 0? "" : rnd(3)? "*" : "+", rnd(10000));
+        put(t, buf);
+    }
+}
+
+void peg_input(Text* t) {
+    char buf[200];
+    for (int i=0; t->len < t->max-200; i++) {
+        int a = rnd(i+1), b = rnd(i+1);
+        switch (rnd(4)) {
+        case 0: sprintf(buf, "r%d = r%d ('+' r%d)* _\n", i, a, b); break;
+        case 1: sprintf(buf, "r%d = [a-zA-Z_] [a-zA-Z0-9_]*  # a name\n", i); break;
+        case 2: sprintf(buf, "r%d = '\"' ~[\"]* '\"' / r%d?\n", i, a); break;
+        default: sprintf(buf, "r%d = (r%d / r%d)+ !'=' &[x] r%d*2..4\n", i, a, b, a);
+        }
+        put(t, buf);
+    }
+}
+
+typedef struct {
+    char* name;
+    char* grammar;
+    void (*input)(Text*);
+} Bench;
+
+Bench benches[] = {
+    { "json", NULL, json_input },
+    { "uri", NULL, uri_input },
+    { "arith", NULL, arith_input },
+    { "peg", NULL, peg_input },
+};
+
+// -- measure ----------------------------------------------------------
+
+double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+long count_nodes(Node* nd) {
+    long n = 1;
+    for (int i=0; i<nd->count; i++) n += count_nodes(nd->nodes[i]);
+    return n;
+}
+
+void run_bench(Bench* b, long size) {
+    double t = now();
+    int compiles = 0;
+    do { // the mean time of the compiles in 50ms
+        peg_free(peg_compile(b->grammar));
+        compiles += 1;
+    } while (now()-t < 0.05);
+    double compile = (now()-t)/compiles;
+    Peg* peg = peg_compile(b->grammar);
+    Text in = { malloc(size+1), 0, size };
+    if (!in.s) panic("malloc..");
+    b->input(&in);
+    if (in.len > size) in.len = size;
+    in.s[in.len] = 0;
+    long before = allocs;
+    t = now();
+    Peg* tree = peg_parse(peg, in.s);
+    double time = now()-t;
+    long parse_allocs = allocs-before;
+    if (peg_err(tree)) {
+        printf("{\"grammar\":\"%s\",\"bytes\":%ld,\"error\":\"parse failed at %lld\"}\n",
+            b->name, in.len, (long long)tree->err->pos);
+        return;
+    }
+    long nodes = count_nodes(peg_tree(tree));
+    int runs = 1;
+    while (time < 0.2 && runs < 1000) { // repeat small inputs
+        peg_free(tree);
+        t = now();
+        tree = peg_parse(peg, in.s);
+        time += now()-t;
+        runs += 1;
+    }
+    time /= runs;
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("{\"grammar\":\"%s\",\"bytes\":%ld,\"mb_s\":%.2f,\"nodes_s\":%.0f,\"nodes\":%ld,"
+        "\"allocs_mb\":%.1f,\"peak_rss_kb\":%ld,\"compile_us\":%.1f}\n",
+        b->name, in.len, in.len/time/1e6, nodes/time, nodes,
+        parse_allocs/(in.len/1e6), ru.ru_maxrss, compile*1e6);
+    fflush(stdout);
+}
+
+long parse_size(char* s) { // 64K, 32M, 1G ..
+    char* end;
+    long n = strtol(s, &end, 10);
+    if (*end == 'K' || *end == 'k') n <<= 10;
+    if (*end == 'M' || *end == 'm') n <<= 20;
+    if (*end == 'G' || *end == 'g') n <<= 30;
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    long max = argc > 1? parse_size(argv[1]) : 32L << 20;
+    benches[0].grammar = json_grammar;
+    benches[1].grammar = uri_grammar;
+    benches[2].grammar = arith_grammar;
+    benches[3].grammar = peg_grammar;
+    int n = sizeof(benches)/sizeof(Bench);
+    for (int i=0; i<n; i++) {
+        if (argc > 2 && strcmp(argv[2], benches[i].name) != 0) continue;
+        for (long size=1024; size<=max; size*=32) {
+            fflush(stdout);
+            pid_t pid = fork(); // a new process for each peak RSS
+            if (pid == 0) {
+                seed += size; // the same input for each run
+                run_bench(&benches[i], size);
+                exit(0);
+            }
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                printf("{\"grammar\":\"%s\",\"bytes\":%ld,\"error\":\"exit %d\"}\n",
+                    benches[i].name, size, WIFEXITED(status)? WEXITSTATUS(status) : -1);
+            }
+        }
+    }
+    return 0;
+}
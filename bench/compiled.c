@@ -0,0 +1,43 @@
+#include <time.h>
+#include "../pPEG.c"
+
+// Compare a grammar compile with a compiled image load (peg_load_compiled):
+//
+//   > cc -O2 bench/compiled.c -o compiled -lpthread
+//   > ./compiled
+//
+// the first compile has cold caches (the boot grammar is static tables),
+// the grammar is pPEG itself.
+
+double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+int main(void) {
+    char* path = "/tmp/pPEG-bench.code";
+    double t = now();
+    Peg* peg = peg_compile(peg_grammar);
+    double first = now()-t;
+    t = now();
+    Peg* again = peg_compile(peg_grammar);
+    double second = now()-t;
+    if (!peg_save_compiled(again, path)) printf("save compiled failed\n");
+    t = now();
+    Peg* loaded = peg_load_compiled(path, peg_grammar);
+    double load = now()-t;
+    if (!loaded) {
+        printf("load compiled failed\n");
+        return 1;
+    }
+    Peg* p = peg_parse(loaded, peg_grammar);
+    printf("compile: first %.1f us, again %.1f us, load %.1f us, parse %s\n",
+        first*1e6, second*1e6, load*1e6, peg_err(p)? "failed" : "ok");
+    peg_free(p);
+    peg_free(loaded);
+    peg_free(again);
+    peg_free(peg);
+    remove(path);
+    return 0;
+}
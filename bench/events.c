@@ -0,0 +1,75 @@
+#include <time.h>
+#include <sys/resource.h>
+#include "../pPEG.c"
+
+// Compare the tree and event mode (peg_parse_events) memory use:
+//
+//   > cc -O2 bench/events.c -o events -lpthread
+//   > ./events tree; ./events events
+//
+// parses 100MB of JSON lines, and reports the peak memory over the input.
+
+char* jsonl_grammar =
+"    lines  = (value '\\n')*                              \n"
+"    value  =  Str / Arr / Obj / num / lit               \n"
+"    Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+"    memb   = Str _':'_ value                            \n"
+"    Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+"    Str    = _DQ chars* _DQ                             \n"
+"    chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+"    esc    = [/bfnrt] / _DQ / _BS / 'u' [0-9a-fA-F]*4   \n"
+"    num    = _int _frac? _exp?                          \n"
+"    _int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+"    _frac  = '.' [0-9]+                                 \n"
+"    _exp   = [eE] [+-]? [0-9]+                          \n"
+"    lit    = 'true' / 'false' / 'null'                  \n"
+"    _      = [ \\t]*                                    \n";
+
+double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+long peak_kb(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+long leaves = 0;
+
+void leaf(void* ctx, int tag, peg_pos start, peg_pos end) {
+    (void)ctx; (void)tag; (void)start; (void)end;
+    leaves += 1;
+}
+
+int main(int argc, char** argv) {
+    bool events = argc > 1 && strcmp(argv[1], "events") == 0;
+    size_t max = 100L*1000*1000;
+    char* s = malloc(max+200);
+    if (!s) panic("malloc..");
+    size_t n = 0;
+    for (int i=0; n<max; i++) {
+        n += sprintf(s+n, "{\"id\": %d, \"tags\": [\"a\", \"b\\t\"], \"v\": [%d.5, true, null]}\n", i, i);
+    }
+    memset(s+n, 0, 200); // touch all the input pages
+    long base = peak_kb();
+    Peg* peg = peg_compile(jsonl_grammar);
+    double t = now();
+    Peg* p;
+    if (events) {
+        PegEvents ev = { NULL, NULL, leaf, NULL };
+        p = peg_parse_events(peg, s, 0, n, &ev);
+    } else {
+        p = peg_parse_text(peg, s, 0, n);
+    }
+    t = now()-t;
+    if (peg_err(p)) peg_print(p);
+    printf("%s: %zu bytes, %.2f MB/s, %ld leaves, peak %ld KB over the input\n",
+        events? "events" : "tree", n, n/t/1e6, events? leaves : 0L, peak_kb()-base);
+    peg_free(p);
+    peg_free(peg);
+    free(s);
+    return 0;
+}
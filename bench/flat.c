@@ -0,0 +1,116 @@
+#include <time.h>
+#include "../pPEG.c"
+
+// Compare the Node tree and the flat tree (peg_flat):
+//
+//   > cc -O2 bench/flat.c -o flat -lpthread
+//   > ./flat
+//
+// reports the tree bytes and the time for a full tree walk,
+// and the time to save the tree, and load it (peg_save_tree).
+
+char* json_grammar =
+"    json   = _ value _                                  \n"
+"    value  =  Str / Arr / Obj / num / lit               \n"
+"    Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+"    memb   = Str _':'_ value                            \n"
+"    Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+"    Str    = _DQ chars* _DQ                             \n"
+"    chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+"    esc    = [/bfnrt] / _DQ / _BS / 'u' [0-9a-fA-F]*4   \n"
+"    num    = _int _frac? _exp?                          \n"
+"    _int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+"    _frac  = '.' [0-9]+                                 \n"
+"    _exp   = [eE] [+-]? [0-9]+                          \n"
+"    lit    = 'true' / 'false' / 'null'                  \n";
+
+double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+long tree_bytes(Node* node, long* count) { // nodes and their bytes
+    *count += 1;
+    long bytes = sizeof(Node) + node->count*sizeof(Node*);
+    for (int i=0; i<node->count; i++) bytes += tree_bytes(node->nodes[i], count);
+    return bytes;
+}
+
+char* json_doc(int width, size_t* size) { // width^2 values
+    char* s = malloc((size_t)width*width*64 + 100);
+    if (!s) panic("malloc..");
+    size_t n = 0;
+    s[n++] = '[';
+    for (int i=0; i<width; i++) {
+        if (i) s[n++] = ',';
+        n += sprintf(s+n, "{\"id\": %d, \"name\": \"item\\t%d\", \"vals\": [", i, i);
+        for (int j=0; j<width/4; j++) {
+            n += sprintf(s+n, "%s%d.5e1, true, \"x\"", j? ", " : "", j);
+        }
+        n += sprintf(s+n, "], \"ok\": null}");
+    }
+    s[n++] = ']';
+    s[n] = 0;
+    *size = n;
+    return s;
+}
+
+long walk_tree(Node* node) { // sum of the leaf spans
+    if (node->count == 0) return node->end - node->start;
+    long sum = 0;
+    for (int i=0; i<node->count; i++) sum += walk_tree(node->nodes[i]);
+    return sum;
+}
+
+long walk_flat(PegFlat* flat, int count) {
+    long sum = 0;
+    for (int i=0; i<count; i++) {
+        if (flat[i].size == 1) sum += flat[i].end - flat[i].start;
+    }
+    return sum;
+}
+
+int main(void) {
+    size_t n;
+    char* doc = json_doc(1000, &n);
+    Peg* peg = peg_compile(json_grammar);
+    Peg* p = peg_parse(peg, doc);
+    if (peg_err(p)) {
+        peg_print(p);
+        return 1;
+    }
+    long count = 0;
+    long bytes = tree_bytes(p->tree, &count);
+    double t = now();
+    long sum = 0;
+    for (int r=0; r<20; r++) sum += walk_tree(p->tree);
+    t = (now()-t)/20;
+    printf("tree: %ld nodes, %ld bytes, walk %.2f ms (%ld)\n", count, bytes, t*1e3, sum/20);
+    double f = now();
+    int flat_count;
+    PegFlat* flat = peg_flat(p, &flat_count);
+    f = now()-f;
+    t = now();
+    sum = 0;
+    for (int r=0; r<20; r++) sum += walk_flat(flat, flat_count);
+    t = (now()-t)/20;
+    printf("flat: %d nodes, %ld bytes, walk %.2f ms (%ld), peg_flat %.2f ms\n",
+        flat_count, (long)(flat_count*sizeof(PegFlat)), t*1e3, sum/20, f*1e3);
+    char* path = "/tmp/pPEG-bench-flat.tree";
+    t = now();
+    if (!peg_save_tree(p, path)) printf("save tree failed\n");
+    t = now()-t;
+    double l = now();
+    Peg* q = peg_load_tree(peg, path, doc);
+    l = now()-l;
+    if (!q) printf("load tree failed\n");
+    sum = walk_flat(peg_flat(q, &flat_count), flat_count);
+    printf("saved: save %.2f ms, load %.3f ms (%ld)\n", t*1e3, l*1e3, sum);
+    remove(path);
+    peg_free(q);
+    peg_free(p);
+    peg_free(peg);
+    free(doc);
+    return 0;
+}
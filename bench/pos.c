@@ -0,0 +1,108 @@
+#include <time.h>
+#include "../pPEG.c"
+
+// Compare the 32-bit and 64-bit input position builds:
+//
+//   > cc -O2 bench/pos.c -o pos32 -lpthread
+//   > cc -O2 -DPEG_POS64 bench/pos.c -o pos64 -lpthread
+//   > ./pos32; ./pos64
+//
+// reports the node size, parse tree bytes and JSON parse throughput.
+// `./pos64 big` also parses an input over 2GB (needs 3GB of memory).
+
+char* json_grammar =
+"    json   = _ value _                                  \n"
+"    value  =  Str / Arr / Obj / num / lit               \n"
+"    Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+"    memb   = Str _':'_ value                            \n"
+"    Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+"    Str    = _DQ chars* _DQ                             \n"
+"    chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+"    esc    = [/bfnrt] / _DQ / _BS / 'u' [0-9a-fA-F]*4   \n"
+"    num    = _int _frac? _exp?                          \n"
+"    _int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+"    _frac  = '.' [0-9]+                                 \n"
+"    _exp   = [eE] [+-]? [0-9]+                          \n"
+"    lit    = 'true' / 'false' / 'null'                  \n";
+
+double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+long tree_bytes(Node* node, long* count) { // nodes and their bytes
+    *count += 1;
+    long bytes = sizeof(Node) + node->count*sizeof(Node*);
+    for (int i=0; i<node->count; i++) bytes += tree_bytes(node->nodes[i], count);
+    return bytes;
+}
+
+char* json_doc(int width, size_t* size) { // width^2 values
+    char* s = malloc((size_t)width*width*64 + 100);
+    if (!s) panic("malloc..");
+    size_t n = 0;
+    s[n++] = '[';
+    for (int i=0; i<width; i++) {
+        if (i) s[n++] = ',';
+        n += sprintf(s+n, "{\"id\": %d, \"name\": \"item\\t%d\", \"vals\": [", i, i);
+        for (int j=0; j<width/4; j++) {
+            n += sprintf(s+n, "%s%d.5e1, true, \"x\"", j? ", " : "", j);
+        }
+        n += sprintf(s+n, "], \"ok\": null}");
+    }
+    s[n++] = ']';
+    s[n] = 0;
+    *size = n;
+    return s;
+}
+
+void big_input(void) { // over 2GB, a fault report beyond the 2GB pos
+    if (sizeof(peg_pos) < 8) {
+        printf("big input needs a -DPEG_POS64 build\n");
+        return;
+    }
+    size_t n = 2200L*1000*1000; // 11M lines of 200
+    char* s = malloc(n+2);
+    if (!s) panic("malloc..");
+    memset(s, 'a', n);
+    s[n] = 'b';
+    s[n+1] = 0;
+    Peg* peg = peg_compile("s = line* \n line = [a]*200 '\\n'? \n");
+    double t = now();
+    Peg* p = peg_parse(peg, s);
+    t = now()-t;
+    printf("big: %zu bytes, %.2f MB/s, ", n+1, (n+1)/t/1e6);
+    peg_print(p); // fell short at 2200000000
+    peg_free(p);
+    peg_free(peg);
+    free(s);
+}
+
+int main(int argc, char** argv) {
+    printf("peg_pos: %d bytes, Node: %d bytes, Frame: %d bytes, Memo: %d bytes\n",
+        (int)sizeof(peg_pos), (int)sizeof(Node), (int)sizeof(Frame), (int)sizeof(Memo));
+    size_t n;
+    char* doc = json_doc(400, &n);
+    Peg* peg = peg_compile(json_grammar);
+    double best = 1e9;
+    long bytes = 0, count = 0;
+    for (int r=0; r<20; r++) {
+        double t = now();
+        Peg* p = peg_parse(peg, doc);
+        t = now()-t;
+        if (peg_err(p)) {
+            peg_print(p);
+            return 1;
+        }
+        if (t < best) best = t;
+        if (r == 0) bytes = tree_bytes(p->tree, &count);
+        peg_free(p);
+    }
+    printf("json: %zu bytes, %ld nodes, %ld tree bytes (%.1f per node), %.2f MB/s\n",
+        n, count, bytes, (double)bytes/count, n/best/1e6);
+    peg_free(peg);
+    free(doc);
+    if (argc > 1 && strcmp(argv[1], "big") == 0) big_input();
+    return 0;
+}
@@ -0,0 +1,751 @@
+// The BOOT grammar: the peg_grammar ptree and its compiled code,
+// generated by tools/boot-gen.c from boot_code(), do not edit.
+
+#define BOOT_NODE(n) struct { peg_pos start; peg_pos end; short int tag; \
+    char data_use; char memo; int count; Slot data; Node* nodes[n]; }
+
+static const Node boot_n2 = { 4, 7, 11, 1, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n4 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n7 = { 15, 19, 11, 1, 0, 0, {{ 1, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n8 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n6 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n7, (Node*)&boot_n8 } };
+static const Node boot_n9 = { 22, 23, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n5 = { 0, 0, 4, 1, 0, 2, {{ 0, 1, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n6, (Node*)&boot_n9 } };
+static const BOOT_NODE(2) boot_n3 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n4, (Node*)&boot_n5 } };
+static const BOOT_NODE(2) boot_n1 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n2, (Node*)&boot_n3 } };
+static const Node boot_n11 = { 15, 19, 11, 1, 0, 0, {{ 1, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n13 = { 62, 64, 11, 1, 0, 0, {{ 11, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n14 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n15 = { 10, 11, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n16 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n17 = { 73, 76, 11, 1, 0, 0, {{ 2, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(5) boot_n12 = { 0, 0, 3, 0, 0, 5, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n13, (Node*)&boot_n14, (Node*)&boot_n15, (Node*)&boot_n16, (Node*)&boot_n17 } };
+static const BOOT_NODE(2) boot_n10 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n11, (Node*)&boot_n12 } };
+static const Node boot_n19 = { 73, 76, 11, 1, 0, 0, {{ 2, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n21 = { 162, 165, 11, 1, 0, 0, {{ 3, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n24 = { 168, 169, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n25 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n26 = { 162, 165, 11, 1, 0, 0, {{ 3, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(3) boot_n23 = { 0, 0, 3, 0, 0, 3, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n24, (Node*)&boot_n25, (Node*)&boot_n26 } };
+static const Node boot_n27 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n22 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n23, (Node*)&boot_n27 } };
+static const BOOT_NODE(2) boot_n20 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n21, (Node*)&boot_n22 } };
+static const BOOT_NODE(2) boot_n18 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n19, (Node*)&boot_n20 } };
+static const Node boot_n29 = { 162, 165, 11, 1, 0, 0, {{ 3, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n31 = { 212, 215, 11, 1, 0, 0, {{ 4, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n32 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n30 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n31, (Node*)&boot_n32 } };
+static const BOOT_NODE(2) boot_n28 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n29, (Node*)&boot_n30 } };
+static const Node boot_n34 = { 212, 215, 11, 1, 0, 0, {{ 4, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n36 = { 262, 265, 11, 1, 0, 0, {{ 5, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n38 = { 266, 269, 11, 1, 0, 0, {{ 13, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n39 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n37 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n38, (Node*)&boot_n39 } };
+static const Node boot_n40 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(3) boot_n35 = { 0, 0, 3, 0, 0, 3, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n36, (Node*)&boot_n37, (Node*)&boot_n40 } };
+static const BOOT_NODE(2) boot_n33 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n34, (Node*)&boot_n35 } };
+static const Node boot_n42 = { 262, 265, 11, 1, 0, 0, {{ 5, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n45 = { 312, 315, 11, 1, 0, 0, {{ 12, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n46 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n44 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n45, (Node*)&boot_n46 } };
+static const Node boot_n47 = { 317, 321, 11, 1, 0, 0, {{ 6, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n43 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n44, (Node*)&boot_n47 } };
+static const BOOT_NODE(2) boot_n41 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n42, (Node*)&boot_n43 } };
+static const Node boot_n49 = { 317, 321, 11, 1, 0, 0, {{ 6, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n51 = { 362, 366, 11, 1, 0, 0, {{ 8, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n52 = { 369, 374, 11, 1, 0, 0, {{ 17, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n53 = { 377, 382, 11, 1, 0, 0, {{ 19, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n54 = { 385, 390, 11, 1, 0, 0, {{ 7, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n55 = { 393, 397, 11, 1, 0, 0, {{ 21, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(5) boot_n50 = { 0, 0, 2, 0, 0, 5, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n51, (Node*)&boot_n52, (Node*)&boot_n53, (Node*)&boot_n54, (Node*)&boot_n55 } };
+static const BOOT_NODE(2) boot_n48 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n49, (Node*)&boot_n50 } };
+static const Node boot_n57 = { 385, 390, 11, 1, 0, 0, {{ 7, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n59 = { 14, 15, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n60 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n61 = { 73, 76, 11, 1, 0, 0, {{ 2, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n62 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n63 = { 21, 22, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(5) boot_n58 = { 0, 0, 3, 0, 0, 5, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n59, (Node*)&boot_n60, (Node*)&boot_n61, (Node*)&boot_n62, (Node*)&boot_n63 } };
+static const BOOT_NODE(2) boot_n56 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n57, (Node*)&boot_n58 } };
+static const Node boot_n65 = { 362, 366, 11, 1, 0, 0, {{ 8, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n68 = { 512, 514, 11, 1, 0, 0, {{ 9, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n69 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n67 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n68, (Node*)&boot_n69 } };
+static const Node boot_n70 = { 62, 64, 11, 1, 0, 0, {{ 11, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n71 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n73 = { 521, 526, 11, 1, 0, 0, {{ 10, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n74 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n72 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n73, (Node*)&boot_n74 } };
+static const Node boot_n76 = { 528, 529, 12, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n77 = { 10, 11, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n75 = { 0, 0, 5, 1, 0, 2, {{ 0, 0, 0, 33, 0, 0, 0 }},
+    { (Node*)&boot_n76, (Node*)&boot_n77 } };
+static const BOOT_NODE(5) boot_n66 = { 0, 0, 3, 0, 0, 5, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n67, (Node*)&boot_n70, (Node*)&boot_n71, (Node*)&boot_n72, (Node*)&boot_n75 } };
+static const BOOT_NODE(2) boot_n64 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n65, (Node*)&boot_n66 } };
+static const Node boot_n79 = { 512, 514, 11, 1, 0, 0, {{ 9, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n80 = { 563, 564, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n78 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n79, (Node*)&boot_n80 } };
+static const Node boot_n82 = { 521, 526, 11, 1, 0, 0, {{ 10, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n84 = { 613, 615, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n85 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n86 = { 62, 64, 11, 1, 0, 0, {{ 11, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n87 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(4) boot_n83 = { 0, 0, 3, 0, 0, 4, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n84, (Node*)&boot_n85, (Node*)&boot_n86, (Node*)&boot_n87 } };
+static const BOOT_NODE(2) boot_n81 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n82, (Node*)&boot_n83 } };
+static const Node boot_n89 = { 62, 64, 11, 1, 0, 0, {{ 11, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n91 = { 663, 670, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n93 = { 673, 684, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n94 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n92 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n93, (Node*)&boot_n94 } };
+static const BOOT_NODE(2) boot_n90 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n91, (Node*)&boot_n92 } };
+static const BOOT_NODE(2) boot_n88 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n89, (Node*)&boot_n90 } };
+static const Node boot_n96 = { 312, 315, 11, 1, 0, 0, {{ 12, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n97 = { 763, 766, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n95 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n96, (Node*)&boot_n97 } };
+static const Node boot_n99 = { 266, 269, 11, 1, 0, 0, {{ 13, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n101 = { 813, 815, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n103 = { 177, 178, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n105 = { 823, 828, 11, 1, 0, 0, {{ 14, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n106 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n104 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n105, (Node*)&boot_n106 } };
+static const BOOT_NODE(2) boot_n102 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n103, (Node*)&boot_n104 } };
+static const BOOT_NODE(2) boot_n100 = { 0, 0, 2, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n101, (Node*)&boot_n102 } };
+static const BOOT_NODE(2) boot_n98 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n99, (Node*)&boot_n100 } };
+static const Node boot_n108 = { 823, 828, 11, 1, 0, 0, {{ 14, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n110 = { 862, 865, 11, 1, 0, 0, {{ 15, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n113 = { 867, 871, 11, 1, 0, 0, {{ 16, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n115 = { 862, 865, 11, 1, 0, 0, {{ 15, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n116 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n114 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n115, (Node*)&boot_n116 } };
+static const BOOT_NODE(2) boot_n112 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n113, (Node*)&boot_n114 } };
+static const Node boot_n117 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n111 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n112, (Node*)&boot_n117 } };
+static const BOOT_NODE(2) boot_n109 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n110, (Node*)&boot_n111 } };
+static const BOOT_NODE(2) boot_n107 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n108, (Node*)&boot_n109 } };
+static const Node boot_n119 = { 862, 865, 11, 1, 0, 0, {{ 15, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n121 = { 679, 682, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n122 = { 22, 23, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n120 = { 0, 0, 4, 1, 0, 2, {{ 0, 1, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n121, (Node*)&boot_n122 } };
+static const BOOT_NODE(2) boot_n118 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n119, (Node*)&boot_n120 } };
+static const Node boot_n124 = { 867, 871, 11, 1, 0, 0, {{ 16, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n125 = { 963, 965, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n123 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n124, (Node*)&boot_n125 } };
+static const Node boot_n127 = { 369, 374, 11, 1, 0, 0, {{ 17, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n129 = { 67, 68, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n130 = { 1066, 1068, 11, 1, 0, 0, {{ 18, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n131 = { 67, 68, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n133 = { 62, 63, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n134 = { 269, 270, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n132 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 1, 0, 0, 0, 0 }},
+    { (Node*)&boot_n133, (Node*)&boot_n134 } };
+static const BOOT_NODE(4) boot_n128 = { 0, 0, 3, 0, 0, 4, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n129, (Node*)&boot_n130, (Node*)&boot_n131, (Node*)&boot_n132 } };
+static const BOOT_NODE(2) boot_n126 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n127, (Node*)&boot_n128 } };
+static const Node boot_n136 = { 1066, 1068, 11, 1, 0, 0, {{ 18, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n139 = { 763, 764, 12, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n140 = { 67, 68, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n138 = { 0, 0, 5, 1, 0, 2, {{ 0, 0, 0, 126, 0, 0, 0 }},
+    { (Node*)&boot_n139, (Node*)&boot_n140 } };
+static const Node boot_n141 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n137 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n138, (Node*)&boot_n141 } };
+static const BOOT_NODE(2) boot_n135 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n136, (Node*)&boot_n137 } };
+static const Node boot_n143 = { 377, 382, 11, 1, 0, 0, {{ 19, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n145 = { 662, 663, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n146 = { 1166, 1169, 11, 1, 0, 0, {{ 20, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n147 = { 670, 671, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(3) boot_n144 = { 0, 0, 3, 0, 0, 3, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n145, (Node*)&boot_n146, (Node*)&boot_n147 } };
+static const BOOT_NODE(2) boot_n142 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n143, (Node*)&boot_n144 } };
+static const Node boot_n149 = { 1166, 1169, 11, 1, 0, 0, {{ 20, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n152 = { 763, 764, 12, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n153 = { 670, 671, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n151 = { 0, 0, 5, 1, 0, 2, {{ 0, 0, 0, 126, 0, 0, 0 }},
+    { (Node*)&boot_n152, (Node*)&boot_n153 } };
+static const Node boot_n154 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n150 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n151, (Node*)&boot_n154 } };
+static const BOOT_NODE(2) boot_n148 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n149, (Node*)&boot_n150 } };
+static const Node boot_n156 = { 393, 397, 11, 1, 0, 0, {{ 21, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n158 = { 1263, 1264, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n161 = { 62, 64, 11, 1, 0, 0, {{ 11, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n163 = { 0, 1, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n164 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n162 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n163, (Node*)&boot_n164 } };
+static const BOOT_NODE(2) boot_n160 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n161, (Node*)&boot_n162 } };
+static const Node boot_n165 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n159 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n160, (Node*)&boot_n165 } };
+static const Node boot_n168 = { 763, 764, 12, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n169 = { 614, 615, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n167 = { 0, 0, 5, 1, 0, 2, {{ 0, 0, 0, 126, 0, 0, 0 }},
+    { (Node*)&boot_n168, (Node*)&boot_n169 } };
+static const Node boot_n170 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n166 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n167, (Node*)&boot_n170 } };
+static const Node boot_n171 = { 614, 615, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(4) boot_n157 = { 0, 0, 3, 0, 0, 4, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n158, (Node*)&boot_n159, (Node*)&boot_n166, (Node*)&boot_n171 } };
+static const BOOT_NODE(2) boot_n155 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n156, (Node*)&boot_n157 } };
+static const Node boot_n173 = { 12, 13, 11, 1, 0, 0, {{ 22, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n177 = { 1314, 1318, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n178 = { 22, 23, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n176 = { 0, 0, 4, 1, 0, 2, {{ 0, 1, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n177, (Node*)&boot_n178 } };
+static const Node boot_n180 = { 1324, 1325, 18, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n183 = { 763, 764, 12, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const Node boot_n184 = { 1316, 1318, 20, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n182 = { 0, 0, 5, 1, 0, 2, {{ 0, 0, 0, 126, 0, 0, 0 }},
+    { (Node*)&boot_n183, (Node*)&boot_n184 } };
+static const Node boot_n185 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n181 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n182, (Node*)&boot_n185 } };
+static const BOOT_NODE(2) boot_n179 = { 0, 0, 3, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n180, (Node*)&boot_n181 } };
+static const BOOT_NODE(2) boot_n175 = { 0, 0, 2, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n176, (Node*)&boot_n179 } };
+static const Node boot_n186 = { 177, 178, 13, 0, 0, 0, {{ 0, 0, 0, 0, 0, 0, 0 }} };
+static const BOOT_NODE(2) boot_n174 = { 0, 0, 4, 1, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n175, (Node*)&boot_n186 } };
+static const BOOT_NODE(2) boot_n172 = { 0, 0, 1, 0, 0, 2, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n173, (Node*)&boot_n174 } };
+static const BOOT_NODE(23) boot_n0 = { 0, 0, 0, 0, 0, 23, {{ 0, 0, 0, 0, 0, 0, 0 }},
+    { (Node*)&boot_n1, (Node*)&boot_n10, (Node*)&boot_n18, (Node*)&boot_n28, (Node*)&boot_n33, (Node*)&boot_n41, (Node*)&boot_n48, (Node*)&boot_n56, (Node*)&boot_n64, (Node*)&boot_n78, (Node*)&boot_n81, (Node*)&boot_n88, (Node*)&boot_n95, (Node*)&boot_n98, (Node*)&boot_n107, (Node*)&boot_n118, (Node*)&boot_n123, (Node*)&boot_n126, (Node*)&boot_n135, (Node*)&boot_n142, (Node*)&boot_n148, (Node*)&boot_n155, (Node*)&boot_n172 } };
+
+static Node* const boot_exps[] = {
+    (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175, (Node*)&boot_n180,
+    (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n5, (Node*)&boot_n5, (Node*)&boot_n7,
+    (Node*)&boot_n8, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175,
+    (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n2, (Node*)&boot_n13,
+    (Node*)&boot_n14, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175,
+    (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n15, (Node*)&boot_n15,
+    (Node*)&boot_n16, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175,
+    (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n17, (Node*)&boot_n17,
+    (Node*)&boot_n11, (Node*)&boot_n21, (Node*)&boot_n22, (Node*)&boot_n22, (Node*)&boot_n24, (Node*)&boot_n25,
+    (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175, (Node*)&boot_n180,
+    (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n26, (Node*)&boot_n26, (Node*)&boot_n19,
+    (Node*)&boot_n30, (Node*)&boot_n31, (Node*)&boot_n29, (Node*)&boot_n36, (Node*)&boot_n37, (Node*)&boot_n37,
+    (Node*)&boot_n38, (Node*)&boot_n40, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176,
+    (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n34,
+    (Node*)&boot_n44, (Node*)&boot_n45, (Node*)&boot_n47, (Node*)&boot_n47, (Node*)&boot_n42, (Node*)&boot_n50,
+    (Node*)&boot_n50, (Node*)&boot_n51, (Node*)&boot_n50, (Node*)&boot_n52, (Node*)&boot_n50, (Node*)&boot_n53,
+    (Node*)&boot_n50, (Node*)&boot_n54, (Node*)&boot_n50, (Node*)&boot_n55, (Node*)&boot_n50, (Node*)&boot_n49,
+    (Node*)&boot_n59, (Node*)&boot_n60, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176,
+    (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n61,
+    (Node*)&boot_n61, (Node*)&boot_n62, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176,
+    (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n63,
+    (Node*)&boot_n63, (Node*)&boot_n57, (Node*)&boot_n67, (Node*)&boot_n68, (Node*)&boot_n70, (Node*)&boot_n70,
+    (Node*)&boot_n71, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175,
+    (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175, (Node*)&boot_n72, (Node*)&boot_n72,
+    (Node*)&boot_n73, (Node*)&boot_n75, (Node*)&boot_n75, (Node*)&boot_n77, (Node*)&boot_n65, (Node*)&boot_n80,
+    (Node*)&boot_n79, (Node*)&boot_n84, (Node*)&boot_n85, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175,
+    (Node*)&boot_n176, (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175,
+    (Node*)&boot_n86, (Node*)&boot_n86, (Node*)&boot_n87, (Node*)&boot_n174, (Node*)&boot_n175, (Node*)&boot_n175,
+    (Node*)&boot_n176, (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181, (Node*)&boot_n175,
+    (Node*)&boot_n82, (Node*)&boot_n91, (Node*)&boot_n92, (Node*)&boot_n92, (Node*)&boot_n89, (Node*)&boot_n97,
+    (Node*)&boot_n96, (Node*)&boot_n100, (Node*)&boot_n100, (Node*)&boot_n101, (Node*)&boot_n100, (Node*)&boot_n103,
+    (Node*)&boot_n104, (Node*)&boot_n104, (Node*)&boot_n105, (Node*)&boot_n100, (Node*)&boot_n99, (Node*)&boot_n110,
+    (Node*)&boot_n111, (Node*)&boot_n111, (Node*)&boot_n113, (Node*)&boot_n114, (Node*)&boot_n114, (Node*)&boot_n115,
+    (Node*)&boot_n108, (Node*)&boot_n120, (Node*)&boot_n119, (Node*)&boot_n125, (Node*)&boot_n124, (Node*)&boot_n129,
+    (Node*)&boot_n130, (Node*)&boot_n130, (Node*)&boot_n131, (Node*)&boot_n131, (Node*)&boot_n132, (Node*)&boot_n132,
+    (Node*)&boot_n127, (Node*)&boot_n137, (Node*)&boot_n136, (Node*)&boot_n145, (Node*)&boot_n146, (Node*)&boot_n146,
+    (Node*)&boot_n147, (Node*)&boot_n147, (Node*)&boot_n143, (Node*)&boot_n150, (Node*)&boot_n149, (Node*)&boot_n158,
+    (Node*)&boot_n159, (Node*)&boot_n159, (Node*)&boot_n161, (Node*)&boot_n162, (Node*)&boot_n162, (Node*)&boot_n166,
+    (Node*)&boot_n166, (Node*)&boot_n171, (Node*)&boot_n171, (Node*)&boot_n156, (Node*)&boot_n174, (Node*)&boot_n175,
+    (Node*)&boot_n175, (Node*)&boot_n176, (Node*)&boot_n175, (Node*)&boot_n180, (Node*)&boot_n181, (Node*)&boot_n181,
+    (Node*)&boot_n175, (Node*)&boot_n173,
+};
+
+static const int boot_ops[] = {
+    6, 0, 0, 125, 2, 4, 123, 0, 0, 0, 65792, 256, 0, 0, 0, 0,
+    33554433, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 97, 14, 1,
+    0, 3, 0, 2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0, 4,
+    124, 3, 123, 10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1, -9217,
+    -1, -1, -1, -1, -1, -1, -1, 256, 2147483647, 4, 124, 5, 7, 6, 1, 0,
+    258, 0, 259, 1, 6, 0, 0, 257, 2, 4, 255, 0, 0, 0, 65792, 256,
+    0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0,
+    3, 229, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1, 0, 0, 0,
+    0, 0, 0, 4, 256, 3, 255, 10, 1, 35, 14, 0, 0, 3, 0, 2304,
+    3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647, 4, 256, 5,
+    7, 7, 1, 0, 1627, 11, 6, 0, 0, 387, 2, 4, 385, 0, 0, 0,
+    65792, 256, 0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    2, 0, 3, 359, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1, 0,
+    0, 0, 0, 0, 0, 4, 386, 3, 385, 10, 1, 35, 14, 0, 0, 3,
+    0, 2304, 3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647, 4,
+    386, 5, 7, 10, 1, 61, 6, 0, 0, 515, 2, 4, 513, 0, 0, 0,
+    65792, 256, 0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    2, 0, 3, 487, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1, 0,
+    0, 0, 0, 0, 0, 4, 514, 3, 513, 10, 1, 35, 14, 0, 0, 3,
+    0, 2304, 3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647, 4,
+    514, 5, 7, 0, 519, 2, 1, 0, 659, 3, 6, 0, 0, 658, 10, 1,
+    47, 6, 0, 0, 654, 2, 4, 652, 0, 0, 0, 65792, 256, 0, 0, 0,
+    0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 626, 14,
+    1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0,
+    4, 653, 3, 652, 10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1,
+    -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647, 4, 653, 5, 7, 0, 659,
+    3, 7, 1, 6, 0, 0, 667, 0, 668, 4, 7, 1, 0, 805, 5, 6,
+    0, 1, 679, 0, 1663, 13, 7, 6, 0, 0, 804, 2, 4, 802, 0, 0,
+    0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 2, 0, 3, 776, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1,
+    0, 0, 0, 0, 0, 0, 4, 803, 3, 802, 10, 1, 35, 14, 0, 0,
+    3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647,
+    4, 803, 5, 7, 1, 6, 0, 1, 813, 0, 1652, 12, 7, 0, 817, 6,
+    1, 2, 32, 952, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16777216, 2,
+    0, 0, 0, 0, 3, 67372036, 67372036, 67372036, 67372036, 67372036, 67372036, 84149252, 67108864, 67372032, 67372036, 67372036,
+    67372036, 67372036, 67372036, 263172, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2, 8, 16, 1, 4, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 924, 0, 1214, 8, 4, 953, 3, 931, 0, 1806,
+    17, 4, 953, 3, 938, 0, 1850, 19, 4, 953, 3, 945, 0, 954, 7, 4,
+    953, 3, 952, 0, 1879, 21, 4, 953, 5, 1, 10, 1, 40, 6, 0, 0,
+    1082, 2, 4, 1080, 0, 0, 0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 1054, 14, 1, 0, 3, 0,
+    2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0, 4, 1081, 3, 1080,
+    10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1,
+    -1, -1, -1, -1, 256, 2147483647, 4, 1081, 5, 7, 0, 519, 2, 6, 0, 0,
+    1210, 2, 4, 1208, 0, 0, 0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 1182, 14, 1, 0, 3, 0,
+    2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0, 4, 1209, 3, 1208,
+    10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1,
+    -1, -1, -1, -1, 256, 2147483647, 4, 1209, 5, 7, 10, 1, 41, 1, 6, 0,
+    1, 1222, 0, 1366, 9, 7, 0, 1627, 11, 6, 0, 0, 1350, 2, 4, 1348,
+    0, 0, 0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 1, 2, 0, 3, 1322, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0,
+    9728, 1, 0, 0, 0, 0, 0, 0, 4, 1349, 3, 1348, 10, 1, 35, 14,
+    0, 0, 3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1,
+    256, 2147483647, 4, 1349, 5, 7, 6, 0, 1, 1358, 0, 1370, 10, 7, 8, 33,
+    1365, 10, 1, 61, 9, 1, 10, 1, 64, 1, 10, 2, 15917, 6, 0, 0,
+    1498, 2, 4, 1496, 0, 0, 0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 1470, 14, 1, 0, 3, 0,
+    2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0, 4, 1497, 3, 1496,
+    10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1,
+    -1, -1, -1, -1, 256, 2147483647, 4, 1497, 5, 7, 0, 1627, 11, 6, 0, 0,
+    1626, 2, 4, 1624, 0, 0, 0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1, 2, 0, 3, 1598, 14, 1, 0, 3, 0,
+    2569, 3341, 8224, 0, 9728, 1, 0, 0, 0, 0, 0, 0, 4, 1625, 3, 1624,
+    10, 1, 35, 14, 0, 0, 3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1,
+    -1, -1, -1, -1, 256, 2147483647, 4, 1625, 5, 7, 1, 13, 0, 0, 0, -2013265922,
+    134217726, 0, 0, 0, 0, 14, 0, 0, -1, 1, 0, 0, 67051520, -2013265922, 134217726, 0,
+    0, 0, 0, 1, 13, 0, 0, 66, 0, 1073741824, 0, 0, 0, 0, 1, 2,
+    4, 1764, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 33619968, 0, 0,
+    0, 0, 33554432, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 1, 0, 3, 1749, 13, 0, 0, -2147481600, 0, 0, 0,
+    0, 0, 0, 4, 1765, 3, 1764, 10, 1, 42, 6, 0, 1, 1762, 0, 1766,
+    14, 7, 4, 1765, 5, 1, 0, 1786, 15, 6, 0, 1, 1785, 0, 1802, 16,
+    6, 0, 1, 1784, 0, 1786, 15, 7, 7, 1, 14, 1, 0, 1, 0, 14640,
+    0, 0, 67043328, 0, 0, 0, 0, 0, 0, 1, 10, 2, 11822, 1, 10, 1,
+    39, 0, 1831, 18, 10, 1, 39, 14, 0, 1, 1, 0, 26985, 0, 0, 0,
+    0, 512, 0, 0, 0, 0, 1, 14, 0, 0, 2, 0, 9728, 65320, 1, -1,
+    -129, -1, -1, -1, -1, -1, -1, 256, 2147483647, 1, 10, 1, 91, 0, 1860, 20,
+    10, 1, 93, 1, 14, 0, 0, 2, 0, 23552, 65374, 1, -1, -1, -536870913, -1,
+    -1, -1, -1, -1, 256, 2147483647, 1, 10, 1, 60, 6, 0, 0, 1905, 0, 1627,
+    11, 14, 0, 0, 1, 0, 8224, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+    7, 14, 0, 0, 2, 0, 15616, 65343, 1, -1, -1073741825, -1, -1, -1, -1, -1,
+    -1, 256, 2147483647, 10, 1, 62, 1, 6, 0, 0, 2052, 2, 4, 2050, 0, 0,
+    0, 65792, 256, 0, 0, 0, 0, 33554433, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 2, 0, 3, 2024, 14, 1, 0, 3, 0, 2569, 3341, 8224, 0, 9728, 1,
+    0, 0, 0, 0, 0, 0, 4, 2051, 3, 2050, 10, 1, 35, 14, 0, 0,
+    3, 0, 2304, 3083, 65294, 1, -9217, -1, -1, -1, -1, -1, -1, -1, 256, 2147483647,
+    4, 2051, 5, 7, 1,
+};
+
+static const int boot_fail[] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 9, -1, -1,
+    -1, -1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 19, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    12, 9, -1, -1, -1, -1, 24, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 24, 34, -1, -1, 36, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 36, 46, -1, -1, -1, -1, -1, -1, 50, -1, -1, -1, -1, -1,
+    -1, 53, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 60, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 53, 63, -1,
+    -1, 50, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 70,
+    -1, -1, -1, -1, -1, -1, 70, 73, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 80, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, -1, -1, -1, 86, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 110, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, 113, -1, -1, 115, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 122, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 115, 125, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 130, -1, -1, 132, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 139,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 132, 142, -1, -1, -1, -1, -1, -1, 142, 145, -1,
+    -1, -1, -1, -1, 145, -1, -1, -1, -1, -1, -1, -1, -1, 152, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 159, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 152, 162, -1, -1, 164, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 171, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 164, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 176, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 186, -1, -1, -1, -1, -1,
+    -1, 186, -1, -1, -1, -1, -1, -1, -1, 192, -1, -1, -1, -1, -1, -1,
+    195, -1, -1, -1, -1, -1, -1, 195, 192, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 204, -1, -1, 206, -1, -1, 208, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 214, -1, -1,
+    216, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 222, -1, -1, -1, -1, -1,
+    -1, 225, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    222, 227, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 229, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 238, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1,
+};
+
+static const int boot_note[] = {
+    0, -1, -1, -1, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, -1, 3, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 4, -1, 5, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 8, -1, 10, -1, -1,
+    -1, 11, -1, -1, 13, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    15, -1, 16, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 17, -1, 18, -1, -1, 20, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 21,
+    -1, -1, 22, 23, -1, -1, 25, -1, -1, -1, 26, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 27, -1, 28, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 29, -1, 30, -1, -1, 32, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 33, -1, 35, -1, -1, 37, -1, -1, -1, 38, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 39, -1, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 41, -1, 42, -1, -1, 44, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 45, -1, 47, -1, -1, 48, 49, -1, -1, 51, -1, -1, -1, 52, -1,
+    -1, 54, -1, -1, -1, 55, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 56, -1, 57,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 58, -1, 59, -1, -1, 61, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 64, -1,
+    -1, -1, 65, 66, -1, -1, -1, 67, -1, -1, -1, 68, 69, -1, -1, 71,
+    -1, -1, -1, 72, -1, -1, -1, 74, -1, -1, -1, 75, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 76, -1, 77, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 78, -1, 79, -1, -1, 81, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 82, -1, 83, 84, -1, -1, -1, 85, -1, -1, -1, 87, -1, -1,
+    88, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 90, -1, 91, -1, -1, -1, -1, 92, -1, 93, -1,
+    -1, -1, -1, 94, -1, 95, -1, -1, -1, -1, 96, -1, 97, -1, -1, -1,
+    -1, 98, -1, 99, -1, -1, -1, -1, 100, 101, 102, -1, -1, 104, -1, -1,
+    -1, 105, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 106, -1, 107, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 108, -1,
+    109, -1, -1, 111, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 112, -1, 114, -1, -1, 116, -1, -1,
+    -1, 117, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 118, -1, 119, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 120, -1,
+    121, -1, -1, 123, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 124, -1, 126, -1, -1, 127, 128, -1,
+    -1, -1, 129, -1, -1, -1, 131, -1, -1, 133, -1, -1, -1, 134, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 135, -1, 136, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 137, -1, 138, -1, -1, 140,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, 141, -1, 143, -1, -1, -1, 144, -1, -1, -1, 146, -1,
+    -1, 147, -1, -1, -1, 148, 149, -1, -1, 150, 151, -1, -1, 153, -1, -1,
+    -1, 154, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 155, -1, 156, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 157, -1,
+    158, -1, -1, 160, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 161, -1, 163, -1, -1, 165, -1, -1,
+    -1, 166, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 167, -1, 168, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 169, -1,
+    170, -1, -1, 172, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 173, -1, 174, 175, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 177, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 178, 179, -1, -1, -1, -1, -1, -1, -1, -1, -1, 180, 181,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 182, -1, 183, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 184, -1, 185, -1, -1, 187, -1, -1, -1, 188, -1,
+    -1, -1, -1, -1, 189, 190, 191, -1, -1, 193, -1, -1, -1, 194, -1, -1,
+    196, -1, -1, -1, 197, -1, -1, -1, -1, 198, 199, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 200, 201, -1, -1, 202, 203, -1,
+    -1, 205, -1, -1, 207, -1, -1, 209, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 210, 211, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 212, 213, -1, -1, 215, -1, -1,
+    217, -1, -1, 218, 219, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 220, 221, -1, -1, 223, -1, -1, -1, 224, -1,
+    -1, 226, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 228, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 230, -1, -1, 231, 232, -1, -1, -1, 233, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 234, -1, 235, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 236, -1, 237, -1, -1, 239, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 240, -1, 241,
+};
+
+static const int boot_exp_rule[] = {
+    22, 22, 22, 22, 22, 22, 22, 22, 22, 0, 0, 0, 0, 22, 22, 22,
+    22, 22, 22, 22, 22, 22, 0, 1, 1, 22, 22, 22, 22, 22, 22, 22,
+    22, 22, 1, 1, 1, 22, 22, 22, 22, 22, 22, 22, 22, 22, 1, 1,
+    1, 2, 2, 2, 2, 2, 22, 22, 22, 22, 22, 22, 22, 22, 22, 2,
+    2, 2, 3, 3, 3, 4, 4, 4, 4, 4, 22, 22, 22, 22, 22, 22,
+    22, 22, 22, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 7, 7, 22, 22, 22, 22, 22, 22, 22, 22,
+    22, 7, 7, 7, 22, 22, 22, 22, 22, 22, 22, 22, 22, 7, 7, 7,
+    8, 8, 8, 8, 8, 22, 22, 22, 22, 22, 22, 22, 22, 22, 8, 8,
+    8, 8, 8, 8, 8, 9, 9, 10, 10, 22, 22, 22, 22, 22, 22, 22,
+    22, 22, 10, 10, 10, 22, 22, 22, 22, 22, 22, 22, 22, 22, 10, 11,
+    11, 11, 11, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 14,
+    14, 14, 14, 14, 14, 14, 14, 15, 15, 16, 16, 17, 17, 17, 17, 17,
+    17, 17, 17, 18, 18, 19, 19, 19, 19, 19, 19, 20, 20, 21, 21, 21,
+    21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22,
+    22, 22,
+};
+
+static const int boot_entry[] = {
+    0, 259, 519, 659, 668, 805, 817, 954, 1214, 1366, 1370, 1627, 1652, 1663, 1766, 1786,
+    1802, 1806, 1831, 1850, 1860, 1879, 1927,
+};
+
+static const char boot_mode[] = {
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 2,
+};
+
+static const char boot_memo[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0,
+};
+
+static const Code boot_code_tables = {
+    (int*)boot_ops, 2053, (int*)boot_fail, (int*)boot_note,
+    (Node**)boot_exps, (int*)boot_exp_rule, 242,
+    (int*)boot_entry, (char*)boot_mode, 23, (char*)boot_memo,
+    MEMO_LIMIT, true, NULL, 0, NULL, NULL
+};
+
+static const Peg boot_peg = {
+    peg_grammar, (Node*)&boot_n0, NULL, NULL, (Code*)&boot_code_tables,
+    NULL, NULL, 0, NULL, 0, false
+};
@@ -1,19 +1,31 @@
 
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE // mmap MAP_ANONYMOUS and madvise with -std=c11
+#endif
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "pPEG.h"
 
-#define MAX_STACK 512
+#define MAX_DEPTH 512
+#define RESULTS_INLINE 64
+#define MEMO_LIMIT (64*1024*1024) // default packrat memo bytes
 
 // -- peg grammar --------------------------------
 
 // TODO update grammar..... seq, rop, group, dq, ...
 
-char* peg_grammar = 
+char peg_grammar[] = 
 "    Peg   = _ (rule _)+                          \n"
 "    rule  = id _ '=' _ alt                       \n"
 "                                                 \n"
@@ -68,9 +80,7 @@ enum op {
     QUOTE, SQ, CHARS, CHS, EXTN, WS
 };
 
-// Parser machine instruction op-codes:
-// ALT, SEQ, REP, PRE, ID, SQ, CHS
-// CALL, AT, MULTI
+// The peg grammar ptree is compiled into parser machine code, see below.
 
 // -- implicit rule names ---------------------------------------------------
 
@@ -123,21 +133,23 @@ typedef union {
 // typedef struct Node Node; // in pPEG.h
 
 struct Node {
+    peg_pos start; // start string span
+    peg_pos end;   // last+1 string span
     short int tag; // rule name index
     char data_use; // enum DATE_USE (use of Slot data)
-    int start;     // start string span
-    int end;       // last+1 string span
+    char memo;     // 1 if the node is shared with the packrat memo
     int count;     // nodes count
     Slot data;     // application data -- op codes
     Node* nodes[]; // children node pointers
 };
 
-enum PEG_ERR { PEG_OK, PEG_PANIC, PEG_FELL_SHORT, PEG_FAILED };
+enum PEG_ERR { PEG_OK, PEG_PANIC, PEG_FELL_SHORT, PEG_FAILED, PEG_UNDEFINED };
 
 char* peg_err_msg[] = {
     "ok", "PANIC",
     "Parse fell short",
-    "Parse failed"
+    "Parse failed",
+    "Undefined rule"
 };
 
 void panic(char* msg) {
@@ -145,47 +157,218 @@ void panic(char* msg) {
     exit(PEG_PANIC);
 }
 
-static Node *newNode(int tag, int i, int j, int n) {
-    Node *nd = (Node *)malloc(sizeof(Node) + n*sizeof(Node *));
-    if (nd == NULL) panic("malloc");
+// -- parse tree node arena ------------------------
+
+// Parse tree nodes are bump allocated from arena blocks, and released
+// all together with the tree. The parser discards the nodes made after
+// a backtrack point by rewinding the arena to a mark.
+
+#define ARENA_BLOCK (64*1024)
+
+typedef struct {
+    int block;   // block index, or -1
+    int used;    // bytes used in the block
+} Mark;
+
+typedef struct Arena {
+    char** blocks;
+    int* sizes;  // block sizes
+    int count;   // blocks allocated
+    int max;     // blocks capacity
+    Mark top;    // next free byte
+    struct Arena* more; // memo nodes shared by the tree, or NULL
+} Arena;
+
+Arena* newArena() {
+    Arena* a = malloc(sizeof(Arena));
+    if (!a) panic("malloc..");
+    a->blocks = NULL;
+    a->sizes = NULL;
+    a->count = 0;
+    a->max = 0;
+    a->top.block = -1;
+    a->top.used = 0;
+    a->more = NULL;
+    return a;
+}
+
+static inline void* arena_alloc(Arena* a, int size) {
+    size = (size+7) & ~7;
+    Mark* t = &a->top;
+    if (t->block < 0 || t->used+size > a->sizes[t->block]) {
+        int b = t->block+1; // next block, may be kept from a rewind
+        if (b == a->count) {
+            if (a->count == a->max) {
+                a->max = a->max? a->max*2 : 16;
+                a->blocks = realloc(a->blocks, a->max*sizeof(char*));
+                a->sizes = realloc(a->sizes, a->max*sizeof(int));
+                if (!a->blocks || !a->sizes) panic("malloc..");
+            }
+            a->blocks[b] = NULL;
+            a->sizes[b] = 0;
+            a->count += 1;
+        }
+        if (a->sizes[b] < size) {
+            free(a->blocks[b]);
+            a->sizes[b] = size > ARENA_BLOCK? size : ARENA_BLOCK;
+            a->blocks[b] = malloc(a->sizes[b]);
+            if (!a->blocks[b]) panic("malloc..");
+        }
+        t->block = b;
+        t->used = 0;
+    }
+    void* p = a->blocks[t->block]+t->used;
+    t->used += size;
+    return p;
+}
+
+void arena_trim(Arena* a) { // free blocks after the top
+    for (int i=a->top.block+1; i<a->count; i++) free(a->blocks[i]);
+    a->count = a->top.block+1;
+}
+
+void arena_free(Arena* a) {
+    if (!a) return;
+    arena_free(a->more);
+    for (int i=0; i<a->count; i++) free(a->blocks[i]);
+    free(a->blocks);
+    free(a->sizes);
+    free(a);
+}
+
+static Node *newNode(Arena* a, int tag, peg_pos i, peg_pos j, int n) {
+    Node *nd = (Node *)arena_alloc(a, sizeof(Node) + n*sizeof(Node *));
     nd->tag = tag;
     nd->data_use = NO_DATA;
+    nd->memo = 0;
     nd->start = i;
     nd->end = j;
     nd->count = n; // number of children nodes
     return nd;
 };
 
-static void drop(Node* node) {
-    if (node->data_use == HEAP_STR) {
-        free(node->data.str.chars);
-    }
-    if (node->data_use == HEAP_ARR) {
-        free(node->data.arr.ints);
-    }
-    for (int i=0; i<node->count; i+=1) {
-        drop(node->nodes[i]);
-    }
-    free(node);
-}
-
 typedef struct Err Err;
 
 struct Err {
     int err; // PEG_ERR
     int fail_rule;
-    int pos;
+    peg_pos pos;
     Node* expected;
 };
 
-Err* newErr(int code, int pos) {
+Err* newErr(int code, peg_pos pos) {
     Err* err = malloc(sizeof(Err));
     if (!err) panic("malloc..");
     err->err = code;
     err->pos = pos;
+    err->fail_rule = 0;
+    err->expected = NULL;
     return err;
 }
 
+// == parser machine code ==========================================
+
+// A grammar ptree is compiled into a flat array of parser machine
+// instructions, each an op-code followed by its inline operands.
+// Rule calls and jumps are resolved into code array indexes (pc).
+
+enum code {    // instruction operands...
+    OP_CALL,    // entry tag      call rule at entry pc
+    OP_RET,     //                rule return, make result node
+    OP_DISPATCH,// m fail end map[64] masks[m]  ALT first byte => alts
+    OP_CHOICE,  // L              push alt backtrack, next alt at L
+    OP_COMMIT,  // L              pop alt backtrack, jump to L
+    OP_FAIL,    //
+    OP_REP,     // min max L      push rep backtrack, exit at L
+    OP_LOOP,    //                end of rep body, repeat or exit
+    OP_PRE,     // sign L         push pre backtrack, exit at L
+    OP_PEND,    //                end of pre body
+    OP_STR,     // len bytes..    'xyz' bytes packed into ints
+    OP_STRI,    // len bytes..    'xyz'i case insensitive
+    OP_TRIE,    // size data..    'xyz' / 'abc'i / ...  literals trie
+    OP_SET,     // n bits[8] ranges[2n]  char set, see Set below
+    OP_SPAN,    // min max k neg lohi[k] set..  repeat of a char set
+    OP_BUILTIN, // code           implicit rule _WS, _NL, ...
+    OP_PRIOR,   // tag            @x or <id x> prior match
+    OP_AND,     // tag            x -> y  or <and x y>  ... AND_END
+    OP_AND_END, //
+    OP_CMP,     // key tag        <eq x> etc  ... CMP_END
+    OP_CMP_END, //
+    OP_BAD      // err            undefined extension
+};
+
+char* code_names[] = { // debug trace display
+    "CALL", "RET", "DISPATCH", "CHOICE", "COMMIT", "FAIL",
+    "REP", "LOOP", "PRE", "PEND",
+    "STR", "STRI", "TRIE", "SET", "SPAN", "BUILTIN",
+    "PRIOR", "AND", "AND_END", "CMP", "CMP_END", "BAD"
+};
+
+enum BAD_CODE { BAD_RULE, BAD_EXTN, BAD_CALL };
+
+enum NODE_MODE { // rule result node...
+    NODE_KEEP,   // Xyz  always a node
+    NODE_ELIDE,  // xyz  no node if only one child
+    NODE_SKIP    // _xyz no node, children are kept
+};
+
+typedef struct Code Code;
+
+struct Env;
+
+struct Code {
+    int* ops;       // instructions: op-codes and operands
+    int len;        // ops count
+    int* fail;      // pc => seq element exps index, or -1
+    int* note;      // pc => grammar exps index, or -1
+    Node** exps;    // grammar ptree nodes, for fault report and debug
+    int* exp_rule;  // exps index => index of the rule it is in
+    int exp_count;
+    int* entry;     // rule index => entry pc
+    char* mode;     // rule index => NODE_MODE
+    int rule_count;
+    char* memo;     // rule index => packrat memo flag
+    int memo_limit; // memo table bytes
+    bool dispatch;  // has ALT dispatch tables
+    char* image;    // the arrays are in this file mapping, or NULL
+    size_t image_size;
+    bool (*run)(struct Env*, int); // generated C parser machine, or NULL
+    PegProfile* profile; // rule counters (peg_profile), or NULL
+};
+
+int code_size(int* ops, int pc) { // instruction length
+    switch (ops[pc]) {
+        case OP_RET: case OP_FAIL: case OP_LOOP: case OP_PEND:
+        case OP_AND_END: case OP_CMP_END: return 1;
+        case OP_CHOICE: case OP_COMMIT: case OP_BUILTIN:
+        case OP_PRIOR: case OP_AND: case OP_BAD: return 2;
+        case OP_CALL: case OP_PRE: case OP_CMP: return 3;
+        case OP_REP: return 4;
+        case OP_DISPATCH: return 4+64+ops[pc+1];
+        case OP_STR: case OP_STRI: return 2+(ops[pc+1]+3)/4;
+        case OP_TRIE: return 2+ops[pc+1];
+        case OP_SET: return 10+2*ops[pc+1];
+        case OP_SPAN: {
+            int k = ops[pc+3] > 0? ops[pc+3] : 0; // byte ranges
+            return 5+k+9+2*ops[pc+5+k];
+        }
+    }
+    return 1;
+}
+
+// -- backtrack stack frames -----------------------------------------
+
+enum FRAME { F_CALL, F_ALT, F_REP, F_PRE, F_MARK };
+
+typedef struct {
+    int kind;   // FRAME
+    int site;   // pc of the instruction that pushed the frame
+    peg_pos pos; // input cursor to reset on backtrack
+    int stack;  // results stack index to reset on backtrack
+    int count;  // CALL rule tag, REP count, ALT mask
+    Mark mark;  // node arena to rewind on backtrack
+} Frame;
+
 // == Peg peg ===================================================
 
 // typedef struct Peg Peg; // in pPEG.h
@@ -195,6 +378,13 @@ struct Peg { // parse tree.........
     Node* tree;  // parse tree indexes into src string
     Peg* peg;    // grammar parse tree
     Err* err;    // error info
+    Code* code;  // parser machine code, if this is a grammar
+    Arena* arena; // parse tree nodes
+    char* buf;   // input owned by the tree (from peg_feed), or NULL
+    size_t map;  // buf is a file mapping of this size, or 0
+    PegFlat* flat; // pre-order parse tree (from peg_flat), or NULL
+    int flat_count;
+    bool flat_map; // flat is in the buf file mapping (peg_load_tree)
 };
 
 Peg* newPeg(char* src, Node* tree, Peg* gram, Err* err) {
@@ -204,29 +394,101 @@ Peg* newPeg(char* src, Node* tree, Peg* gram, Err* err) {
     peg->tree = tree;
     peg->peg = gram;
     peg->err = err;
+    peg->code = NULL;
+    peg->arena = NULL;
+    peg->buf = NULL;
+    peg->map = 0;
+    peg->flat = NULL;
+    peg->flat_count = 0;
+    peg->flat_map = false;
     return peg;
 }
 
-// == Env for parser machine ========================================
+// -- packrat memo -------------------------------------------------
+
+typedef struct {
+    int tag;      // rule index, or -1 for an empty slot
+    peg_pos pos;  // rule start
+    peg_pos end;  // rule end, or fail pos
+    int count;    // result nodes count, or -1 if the rule failed
+    int multi;    // x -> y marked nodes in the result
+    Node** nodes; // copy of the result nodes
+} Memo;
+
+// -- rescan heatmap -----------------------------------------------
+
+#define HEAT_BUCKET 64 // default input bytes in a bucket
+#define HEAT_TOP 5     // hottest buckets reported
+#define HEAT_DEPTH 6   // inner-most rule calls in a stack
+#define HEAT_STACKS 8  // rule stacks kept for each hot bucket
+
+typedef struct {
+    int depth;
+    int tags[HEAT_DEPTH]; // rule calls, inner-most first
+    bool deeper;   // more calls outside these
+    long long count;
+} HeatStack;
 
 typedef struct {
+    int bucket;    // input bytes in a bucket
+    int size;      // buckets
+    long long* counts; // rescans of each bucket, deltas in the first run
+    bool record;   // second run, record the stacks for the top buckets
+    int failed;    // frames top where a backtrack started, or 0
+    int top[HEAT_TOP]; // hottest buckets
+    int top_count;
+    HeatStack stacks[HEAT_TOP][HEAT_STACKS];
+    int stack_count[HEAT_TOP];
+    long long other[HEAT_TOP]; // rescans from stacks that did not fit
+} Heat;
+
+// == Env for parser machine ========================================
+
+typedef struct Env {
     char* grammar;  // source text
     Node* tree;     // peg rules
+    Code* code;     // parser machine code
     char* input;
-    int start;
-    int pos;        // parser cursor
-    int end;        // end of input string (or end of % span)
+    peg_pos start;
+    peg_pos pos;    // parser cursor
+    peg_pos end;    // end of input string (or end of % span)
+    bool more;      // more input may follow the end (peg_feed)
+    int resume;     // pc to resume a run that needs more input, or -1
+    peg_pos span_start; // a span suspended at the end of the input,
+    int span_count;     //   its start and chars so far, or count -1
     int depth;      // rule call depth (catch recursion)
     int stack;      // index into parse result Nodes
-    Node* results[MAX_STACK]; // TODO elastic?
+    Node** results; // result nodes stack
+    int results_max; // results capacity
+    Node* results_buf[RESULTS_INLINE]; // initial results, then heap
+    int top;        // index into backtrack frames
+    int frame_max;  // frames capacity
+    Frame* frames;  // backtrack stack
+    Arena* arena;   // result nodes
+    Memo* memo;     // packrat memo table, or NULL
+    int memo_size;  // memo slots, a power of 2
+    int memo_count; // memo entries
+    long memo_bytes;
+    Arena* memo_arena; // memo result nodes
+
+    PegEvents* events; // event mode callbacks, or NULL
+    bool release;   // event mode, final results are sent and released
+    int sent;       // results below this have been sent
+    int* entered;   // frame index of the calls that have been sent an enter
+    int entered_count;
+    int entered_max;
 
     int multi; // multi-rule node count
 
+    PegProfile* profile; // rule counters for this parse, or NULL
+    Heat* heat; // input rescan counts (peg_heatmap), or NULL
+
     int flags; // debug, trace
-    int trace_pos;
+    bool dispatch; // use ALT dispatch tables
+    peg_pos trace_pos;
     int trace_depth;
     bool trace_open;
-    int fail;
+    peg_pos fail;
     int fail_rule;
     Node* expected;
 } Env;
@@ -235,7 +497,7 @@ typedef struct {
 
     0-7F            0xxx xxxx
     80-7FF          110x xxxx 10xx xxxx
-    800-7FFF        1110 xxxx 10xx xxxx 10xx xxxx
+    800-FFFF        1110 xxxx 10xx xxxx 10xx xxxx
     10000-10FFFF    1111 0xxx 10xx xxxx 10xx xxxx 10xx xxxx
 
 */
@@ -243,13 +505,13 @@ typedef struct {
 int utf8_size(int x) {
     if (x < 128) return 1;
     if (x < 0x800) return 2;
-    if (x < 0x8000) return 3;
+    if (x < 0x10000) return 3;
     return 4;
 }
 
 int utf8_len(char* p) {
     unsigned int c = (unsigned char)p[0];
-    if (c < 127) return 1;            
+    if (c < 128) return 1;
     int x = c<<1, i = 2;
     while ((x <<= 1) & 0x80) i++;
     return i;
@@ -257,7 +519,7 @@ int utf8_len(char* p) {
 
 int utf8_read(char* p) {
     unsigned int c = (unsigned char)p[0];
-    if (c < 127) return c;            
+    if (c < 128) return c;
     int x = c<<1, i = 2;
     while ((x <<= 1) & 0x80) i++;
     x = (x & 0xFF) >> i;
@@ -265,6 +527,24 @@ int utf8_read(char* p) {
     return x;
 }
 
+// decode the char at p, of at most len bytes, an invalid UTF-8 byte
+// is taken as a single char code...
+static inline int utf8_code(char* p, peg_pos len, int* size) {
+    unsigned int c = (unsigned char)p[0];
+    *size = 1;
+    if (c < 0xC0) return c;
+    int n = c < 0xE0? 2 : c < 0xF0? 3 : c < 0xF8? 4 : 1;
+    if (n == 1 || n > len) return c;
+    int x = c & (0x7F >> n);
+    for (int i=1; i<n; i++) {
+        unsigned int b = (unsigned char)p[i];
+        if ((b & 0xC0) != 0x80) return c;
+        x = (x<<6) + (b & 0x3F);
+    }
+    *size = n;
+    return x;
+}
+
 int utf8_write(char* p, int x) {
     if (x < 128) {
         *p = x;
@@ -275,7 +555,7 @@ int utf8_write(char* p, int x) {
         *(p+1) = 0x80 + (x & 0x3F);
         return 2;
     }
-    if (x < 0x8000) { // 1110 xxxx 10xx xxxx 10xx xxxx
+    if (x < 0x10000) { // 1110 xxxx 10xx xxxx 10xx xxxx
         *p = 0xE0 + (x >> 12);
         *(p+1) = 0x80 + ((x >> 6) & 0x3F);
         *(p+2) = 0x80 + (x & 0x3F);       
@@ -289,20 +569,93 @@ int utf8_write(char* p, int x) {
     return 4;
 }
 
+// -- case folding -------------------------------------------------
+
+// 'xyz'i literals are folded to upper case at compile time, the input
+// is folded as it is matched: ASCII bytes by table, other chars by the
+// simple case folds of the main alphabets. A fold never changes the
+// UTF-8 length, and ASCII letters only fold with ASCII letters (so the
+// long s and Kelvin sign folds are left out).
+
+static const unsigned char upper_case[256] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+    0x60, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+    0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+// lo hi delta: lower case lo..hi folds to lo+delta..hi+delta
+// lo hi 0: upper, lower case pairs from lo
+static const int case_folds[][3] = {
+    { 0x61, 0x7A, -32 }, { 0xB5, 0xB5, 743 }, { 0xE0, 0xF6, -32 },
+    { 0xF8, 0xFE, -32 }, { 0xFF, 0xFF, 121 }, { 0x100, 0x12F, 0 },
+    { 0x132, 0x137, 0 }, { 0x139, 0x148, 0 }, { 0x14A, 0x177, 0 },
+    { 0x179, 0x17E, 0 }, { 0x1CD, 0x1DC, 0 }, { 0x1DE, 0x1EF, 0 },
+    { 0x1F8, 0x21F, 0 }, { 0x222, 0x233, 0 }, { 0x3AC, 0x3AC, -38 },
+    { 0x3AD, 0x3AF, -37 }, { 0x3B1, 0x3C1, -32 }, { 0x3C2, 0x3C2, -31 },
+    { 0x3C3, 0x3CB, -32 }, { 0x3CC, 0x3CC, -64 }, { 0x3CD, 0x3CE, -63 },
+    { 0x3D8, 0x3EF, 0 },
+    { 0x430, 0x44F, -32 }, { 0x450, 0x45F, -80 }, { 0x460, 0x481, 0 },
+    { 0x48A, 0x4BF, 0 }, { 0x4C1, 0x4CE, 0 }, { 0x4D0, 0x52F, 0 },
+    { 0x561, 0x586, -48 }, { 0x1E00, 0x1E95, 0 }, { 0x1EA0, 0x1EFF, 0 },
+    { 0x2170, 0x217F, -16 }, { 0x24D0, 0x24E9, -26 }, { 0xFF41, 0xFF5A, -32 },
+    { 0x10428, 0x1044F, -40 },
+};
+
+#define CASE_FOLDS (int)(sizeof(case_folds)/sizeof(case_folds[0]))
+
+static inline int case_fold(int c) { // upper case of char c
+    if (c < 128) return upper_case[c];
+    int i = 0, j = CASE_FOLDS-1;
+    while (i <= j) {
+        int k = (i+j)/2;
+        const int* f = case_folds[k];
+        if (c < f[0]) j = k-1;
+        else if (c > f[1]) i = k+1;
+        else if (f[2]) return c+f[2];
+        else return c-((c-f[0]) & 1);
+    }
+    return c;
+}
+
+int case_alts(int c, int* alts) { // chars that fold with c, at most 4
+    int u = case_fold(c);
+    int n = 0;
+    alts[n++] = u;
+    for (int i=0; i<CASE_FOLDS; i++) {
+        const int* f = case_folds[i];
+        if (f[2] && u-f[2] >= f[0] && u-f[2] <= f[1]) alts[n++] = u-f[2];
+        if (!f[2] && u >= f[0] && u < f[1] && !((u-f[0]) & 1)) alts[n++] = u+1;
+    }
+    return n;
+}
+
 // -- node utils ---------------------------------
 
 char* node_txt(char* str, Node* nd, char* out, int len, int extra) { // extra for escape codes
     char *out1 = out;
-    int start = nd->start;
-    int end = nd->end;
-    int span = end - start; // text len
-    int chop = span + extra - len; // excess text 
+    peg_pos start = nd->start;
+    peg_pos end = nd->end;
+    peg_pos span = end - start; // text len
+    peg_pos chop = span + extra - len; // excess text 
     if (chop > 0 && len < 13) { // 1234 ... 0123
         printf("woops, node_text buffer too small....\n");
         return out;
     }
-    int mid = start + (len >> 1) - 4;
-    for (int i = start; i < end; i += 1) {
+    peg_pos mid = start + (len >> 1) - 4;
+    for (peg_pos i = start; i < end; i += 1) {
         if (out-out1 > len-4) { // escapes have over-run length calculation..
             return node_txt(str, nd, out1, len, extra+4); // try again..
         }
@@ -390,9 +743,38 @@ void print_tree(Peg* peg, Node* nd, int inset, unsigned long long last) {
     printf(" %s\n", txt);
 }
 
+void print_flat(Peg* peg, int i, int inset, unsigned long long last) {
+    for (int j=0; j<inset; j++) { // same as print_tree
+        if (j == inset-1) {
+            if (last&(0x1ULL<<inset)) printf("%s", "\u2514\u2500");  // `-
+                else printf("%s", "\u251C\u2500");   // |-
+        }
+        else if (last&(0x1ULL<<(j+1))) printf("%s", "  ");
+            else printf("%s", "\u2502 ");  // |
+    }
+    PegFlat* fl = peg->flat+i;
+    print_tag(peg, fl->tag);
+    if (fl->size > 1) {
+        printf("\n");
+        for (int k=i+1; k<i+fl->size; k+=peg->flat[k].size) {
+            if (k+peg->flat[k].size == i+fl->size) last = last|(0x1ULL<<(inset+1));
+            print_flat(peg, k, inset+1, last);
+        }
+        return;
+    }
+    Node nd = { .start = fl->start, .end = fl->end };
+    char txt[100];
+    char* t = &txt[0];
+    t = node_quote(peg->src, &nd, t, 100);
+    *t = '\0';
+    printf(" %s\n", txt);
+}
+
 void print_ptree(Peg* peg) {
     if (peg && peg->tree) {
         print_tree(peg, peg->tree, 0, 0);
+    } else if (peg && peg->flat) {
+        print_flat(peg, 0, 0, 0);
     } else {
         printf("No ptree...\n");
     }
@@ -400,43 +782,53 @@ void print_ptree(Peg* peg) {
 
 // -- fault reporting ----------------------------------------
 
-void print_cursor(char* p, int pos) {
-    int i = pos;
+void print_cursor(char* p, peg_pos pos) {
+    peg_pos i = pos;
     while (i>0 && p[i]<' ') i--; // back-off eol
     while (i > 0 && pos-i < 32 && p[i]>=' ') i--;
-    int j = pos;
+    peg_pos j = pos;
     while (p[j] != 0 && p[j]<' ') j++; // advance over eol
     while (p[j] != 0 && j-pos < 32 && p[j]>=' ') j++;
-    for (int k=i; k<j; k++) { 
+    for (peg_pos k=i; k<j; k++) { 
         char c = p[k];
         if (c < ' ') c = ' ';
         printf("%c", c);
     }
     printf("\n");   
-    for (int k=i; k<pos; k++) {
+    for (peg_pos k=i; k<pos; k++) {
         printf(" ");
         k += utf8_len(p+k)-1;
     }
     printf("^\n");
 }
 
-void print_line_num(char* p, int pos) {
-    int cr = 0;
-    int lf = 0;
-    int i = pos;
+void print_line_num(char* p, peg_pos pos) {
+    peg_pos cr = 0;
+    peg_pos lf = 0;
+    peg_pos i = pos;
     while (i > 0 && (unsigned char)p[i] >= ' ') i--;
-    int col = pos-i;
+    peg_pos col = pos-i;
     do {
         if (p[i] == '\n') lf++;
         if (p[i] == '\r') cr++;
     } while (i-- > 0);
-    int ln = lf > cr? lf : cr;
-    printf("%d.%d", ln+1, col+1);
+    peg_pos ln = lf > cr? lf : cr;
+    printf("%lld.%lld", (long long)ln+1, (long long)col+1);
 }
 
 // -- fault report -----------------------------------------
 
 void fault_report(Peg* peg) {
+    if (peg->err->err == PEG_UNDEFINED) { // grammar compile error
+        printf("%s: ", peg_err_msg[PEG_UNDEFINED]);
+        print_text(peg->src, peg->err->expected);
+        printf("\n");
+        printf("on line: ");
+        print_line_num(peg->src, peg->err->pos);
+        printf(" at: %lld of %lu\n", (long long)peg->err->pos, strlen(peg->src));
+        print_cursor(peg->src, peg->err->pos);
+        return;
+    }
     printf("%s in rule: ", peg_err_msg[peg->err->err]);
     print_tag(peg, peg->err->fail_rule);
     printf("\n");
@@ -451,29 +843,35 @@ void fault_report(Peg* peg) {
     }
     printf("on line: ");
     print_line_num(peg->src, peg->err->pos);
-    printf(" at: %d of %lu\n", peg->err->pos, strlen(peg->src));
+    printf(" at: %lld of %lu\n", (long long)peg->err->pos, strlen(peg->src));
     print_cursor(peg->src, peg->err->pos);
 } 
 
 // -- debug trace op codes display ---------------------------------
 
-void show_exp(Env *pen, Node *exp, char* out, int len) {
-    int tag = exp->tag;
-    char *name = peg_names[tag];
+void show_op(Env *pen, int pc, char* out, int len) {
+    int* ops = pen->code->ops;
+    int op = ops[pc];
+    char *name = code_names[op];
     int n = strlen(name);
-    if (n+2 > len) panic("show_exp overflow...");
+    if (n+2 > len) panic("show_op overflow...");
     strcpy(out, name);
     out += n; // strlen(name);
     *out++ = ' ';
-    if (tag == ID || tag == SQ || tag == CHS) {
-        out = node_quote(pen->grammar, exp, out, len-(n+3));
+    int i = pen->code->note[pc];
+    if (i >= 0) {
+        Node* exp = pen->code->exps[i];
+        if (exp->tag == ID || exp->tag == SQ || exp->tag == CHS ||
+            op == OP_SET || op == OP_TRIE) {
+            out = node_quote(pen->grammar, exp, out, len-(n+3));
+        }
     }
-    if (tag == PRE) {
-        *out++ = exp->data.opx.sign;
+    if (op == OP_PRE) {
+        *out++ = ops[pc+1];
     }
-    if (tag == REP) {
-        int min = exp->data.opx.min;
-        int max = exp->data.opx.max;
+    if (op == OP_REP) {
+        int min = ops[pc+1];
+        int max = ops[pc+2];
         if (min==0 && max==0) *out++ = '*';
         if (min==1 && max==0) *out++ = '+';
         if (min==0 && max==1) *out++ = '?';
@@ -481,20 +879,20 @@ void show_exp(Env *pen, Node *exp, char* out, int len) {
     *out = '\0';
 }
 
-void debug_trace(Env *pen, Node* exp) {
+void debug_trace(Env *pen, int pc) {
     char c = pen->input[pen->pos];
     if (c == '\n') c = ' ';
-    printf("%d: %c\t", pen->pos - pen->start, c);
+    printf("%lld: %c\t", (long long)(pen->pos - pen->start), c);
     char show[100];
-    show_exp(pen, exp, show, 99);
+    show_op(pen, pc, show, 99);
     printf("%s\n", show);
 }
 
 // -- rule trace ---------------------------------------------
 
-void trace_quote(char* str, int start, int end) {
+void trace_quote(char* str, peg_pos start, peg_pos end) {
     printf("\"");
-    for (int i=start; i<end; i++) {
+    for (peg_pos i=start; i<end; i++) {
         char c = str[i];
         if (c == '\n') printf("\\n");
         else if (c == '\"') printf("\\\"");
@@ -579,22 +977,16 @@ int implicit_rule(char* name, int len) {
     return _CHAR; // implicit character code 
 }
 
-bool implicit_range(Node* exp, int min, int max) {
-    exp->data.range.min = min;
-    exp->data.range.max = max;
-    exp->data_use = RANGE_DATA;
-    return true;
-}
-
-bool implicit_builtin(Node* exp, int code) {
-    exp->data.opx.builtin = code;
-    exp->data_use = BUILTIN;
-    return true;
+int implicit_range(int* range, int min, int max) {
+    range[0] = min;
+    range[1] = max;
+    return _CHAR;
 }
 
-bool resolve_implicit(Node* exp, char* name, int len) {
+// returns _CHAR with a char code range[2], or a builtin, or _NULL
+int resolve_implicit(char* name, int len, int* range) {
     int imp = implicit_rule(name, len); // validate hex digits..
-    if (imp == _NULL) return false;
+    if (imp == _NULL) return _NULL;
     if (imp == _CHAR) {
         int min = 0, max = 0;
         for (int i=1; i<len; i+=1) {
@@ -609,45 +1001,33 @@ bool resolve_implicit(Node* exp, char* name, int len) {
             min = (min<<4) + c-(c>='0'&&c<='9'? '0' : 55); // 'A'=65
         }
         if (max < min) max = min;
-        return implicit_range(exp, min, max);
-    }
-    // if (imp == _WS) return implicit_range(exp, 0x9, 0x20); // => BUILTIN
-    if (imp == _TAB) return implicit_range(exp, 0x9, 0x9);
-    if (imp == _LF) return implicit_range(exp, 0xA, 0xA);
-    if (imp == _CR) return implicit_range(exp, 0xD, 0xD);
-    if (imp == _BS) return implicit_range(exp, 0x5C, 0x5C); // back slash
-    if (imp == _SQ) return implicit_range(exp, 0x27, 0x27);
-    if (imp == _DQ) return implicit_range(exp, 0x22, 0x22);
-    if (imp == _BT) return implicit_range(exp, 0x60, 0x60); // back tick `
-    if (imp == _EOL) return implicit_range(exp, 0xA, 0xD);
-    if (imp == _ANY) return implicit_range(exp, 0x0, 0x10FFFF);
+        return implicit_range(range, min, max);
+    }
+    // if (imp == _WS) return implicit_range(range, 0x9, 0x20); // => BUILTIN
+    if (imp == _TAB) return implicit_range(range, 0x9, 0x9);
+    if (imp == _LF) return implicit_range(range, 0xA, 0xA);
+    if (imp == _CR) return implicit_range(range, 0xD, 0xD);
+    if (imp == _BS) return implicit_range(range, 0x5C, 0x5C); // back slash
+    if (imp == _SQ) return implicit_range(range, 0x27, 0x27);
+    if (imp == _DQ) return implicit_range(range, 0x22, 0x22);
+    if (imp == _BT) return implicit_range(range, 0x60, 0x60); // back tick `
+    if (imp == _EOL) return implicit_range(range, 0xA, 0xD);
+    if (imp == _ANY) return implicit_range(range, 0x0, 0x10FFFF);
     
-    if (imp == _EOF) return implicit_builtin(exp, _EOF); // _9-D / ' '
-    if (imp == _NL) return implicit_builtin(exp, _NL);   // _LF / _CR _LF?
-    if (imp == _WS) return implicit_builtin(exp, _WS);   // _9-D / ' '
-    if (imp == _UNDERSCORE) return implicit_builtin(exp, _UNDERSCORE); // _WS*
-
-    return false; // undefined implicit rule name
+    // _EOF  !_ANY
+    // _NL   _LF / _CR _LF?
+    // _WS   _9-D / ' '
+    // _     _WS*
+    if (imp == _EOF || imp == _NL || imp == _WS || imp == _UNDERSCORE) {
+        return imp; // builtin
+    }
+    return _NULL; // undefined implicit rule name
 }
 
 // -- Implicit Rules ----------------------------------------------
-      
-bool implicit_code(Env *pen, Node *exp) { // implicit char rule name
-    if (pen->pos >= pen->end) return false;
-    int c = (unsigned char)pen->input[pen->pos];
-    int size = 1; // char bytes...
-    if (c > 127) {
-        c = utf8_read(pen->input);
-        size = utf8_size(c);
-    }
-    if (c < exp->data.range.min) return false;
-    if (c > exp->data.range.max) return false;
-    pen->pos += size;
-    return true;
-}
 
-bool builtin(Env *pen, Node *exp) { // implicit rule...
-    switch (exp->data.opx.builtin) {
+bool builtin(Env *pen, int code) { // implicit rule...
+    switch (code) {
         case _WS: { // _WS = _9-D / ' '
             if (pen->pos >= pen->end) return false;
             char c = pen->input[pen->pos];
@@ -689,35 +1069,7 @@ bool builtin(Env *pen, Node *exp) { // implicit rule...
     return false;
 }
 
-// -- resolve opx data slot extensions -------------------
-
-void resolve_id(Env* pen, Node* exp) {
-    char name[100];
-    char *p = node_text(pen->grammar, exp, name, 100);
-    *p = '\0';
-    int len = p-name;
-    for (int i=0; i<pen->tree->count; i++) {
-        Node* id = pen->tree->nodes[i]->nodes[0];
-        int n = id->end-id->start;
-        if (n != len) continue;
-        bool match = true;
-        for (int j=0; j<len; j++) {
-            if (pen->grammar[id->start+j] != name[j]) {
-                match = false;
-                break;
-            }
-        }
-        if (!match) continue;
-        exp->data.opx.idx = i;
-        exp->data_use = DATA_VALS;
-        return;
-    }
-    if (!resolve_implicit(exp, name, len)) {
-        char msg[50];
-        sprintf(msg, "*** Undefined rule: %s\n", name); // TODO improve this..
-        panic(msg);
-    }
-}
+// -- grammar operand data -------------------------------------
 
 unsigned char rep_num(char* src, int start, int end) {
     int num = 0;        
@@ -732,37 +1084,6 @@ unsigned char rep_num(char* src, int start, int end) {
     return (unsigned char)num;
 }
 
-void resolve_rep(Env* pen, Node* exp) {
-    unsigned char max=0, min=0;
-    Node* sfx = exp->nodes[1];
-    if (sfx->tag == SFX) {
-        char sign = pen->grammar[sfx->start];
-        if (sign == '+') min = 1;
-        if (sign == '?') max = 1;
-    } else if (sfx->tag == NUM) {
-        min = rep_num(pen->grammar, sfx->start, sfx->end);
-        max = min;
-    } else if (sfx->tag == RANGE) { // range = num (dots num?)?
-        Node* num1 = sfx->nodes[0];
-        min = rep_num(pen->grammar, num1->start, num1->end);
-        max = 0; // *Min..
-        if (sfx->count == 3) { // *Min..Max
-            Node* num2 = sfx->nodes[2];
-            max = rep_num(pen->grammar, num2->start, num2->end);
-        }
-    } else panic("woops..");
-    exp->data.opx.min = min;
-    exp->data.opx.max = max;
-    exp->data_use = DATA_VALS;
-}
-
-void resolve_pre(Env* pen, Node* exp) {
-    Node* pfx = exp->nodes[0];
-    char sign = pen->grammar[pfx->start];
-    exp->data.opx.sign = sign;
-    exp->data_use = DATA_VALS;
-}
-
 int hex(int n, char *src) {
     int code = 0;
     for (int i=0; i<n; i++) {
@@ -778,10 +1099,10 @@ int hex(int n, char *src) {
     return code;
 }
 
-int node_ints(Env* pen, Node* exp, int *out) {
+int node_ints(char* grammar, Node* exp, int *out) {
     int *start = out;
     int len = exp->end - exp->start;
-    char *src = pen->grammar + exp->start;
+    char *src = grammar + exp->start;
     for (int i=0; i<len; i++) {
         unsigned char c = src[i];
         if (c>127) {
@@ -812,34 +1133,7 @@ int node_ints(Env* pen, Node* exp, int *out) {
     return out-start; // length
 }
 
-void resolve_sq(Env* pen, Node* exp) {
-    int codes[128];
-    int len = node_ints(pen, exp, codes);
-    char *str = malloc(len+1); // [0]=len
-    if (str == NULL) panic("malloc");
-    char *res = str+1;
-    for (int i=0; i<len; i++) {
-        res += utf8_write(res, codes[i]); // res += utf8_size
-    }
-    str[0] = (res-str)-1;
-    exp->data.str.chars = str;
-    exp->data_use = HEAP_STR;
-}
-
-void resolve_chs(Env* pen, Node* exp) {
-    int codes[128];
-    int len = node_ints(pen, exp, codes);
-    int *vals = malloc(sizeof(int)*(len+1)); // [0]=len
-    if (vals == NULL) panic("malloc");
-    vals[0] = len;
-    for (int i=0; i<=len; i++) {
-        vals[i+1] = codes[i];
-    }
-    exp->data.arr.ints = vals;
-    exp->data_use = HEAP_ARR;
-}
-
-// --- Resolve extensions ------------------------------------------------
+// --- extensions ------------------------------------------------
 
 char *extn_names[] = {
     "and", "id",  "eq", "lt", "gt", "le", "ge"
@@ -850,7 +1144,7 @@ enum extn_tag {
     EXT_eq, EXT_lt, EXT_gt, EXT_le, EXT_ge
 };
 
-void resolve_extn(Env* pen, Node* exp) {
+int extn_tag(char* grammar, Node* exp) { // <cmd ... > extn_tag, or -1
     int tag = -1; // EXT_undefined
     if (exp->count > 0) { // <cmd ... >
         Node* cmd = exp->nodes[0];
@@ -860,7 +1154,7 @@ void resolve_extn(Env* pen, Node* exp) {
             char *key = extn_names[i];
             int k = 0;
             for (int j=cmd->start; j<cmd->end; j++) {
-                 if (key[k] != pen->grammar[j]) break;
+                 if (key[k] != grammar[j]) break;
                  k += 1;
             }
             if (k == cmd_len) {
@@ -868,47 +1162,32 @@ void resolve_extn(Env* pen, Node* exp) {
                 break;
             }
         } // ... ext_names[i]
-        for (int i=1; i<exp->count; i++) {
-            Node* arg = exp->nodes[i];
-            resolve_id(pen, arg); // <cmd id-args...>
-        }
     }
-    exp->data.opx.idx = tag;
-    exp->data_use = DATA_VALS;
+    return tag;
 }
 
 // -- Extension ops -------------------------------------------------
 
-bool run(Env *, Node *); // extensions call parser machine
-
-// <cmd x y z ... >  resolved into:  exp = [extn [x, y, z ...]]
+bool run(Env *, int); // extensions call parser machine
 
 // <and x y>  or experimental: x -> y
+// compiled into:  AND y, CALL x, AND_END
 
-bool ext_and_ids(Env *pen, Node *id1, Node *id2) { // id1 -> id2
-    int start = pen->pos;
-    int stack = pen->stack;
-    bool result = run(pen, id1);
-    if (result && pen->stack > stack) {
+void ext_and_end(Env *pen, Frame* f, int tag2) { // x matched, mark for y
+    peg_pos start = f->pos;
+    int stack = f->stack;
+    if (pen->stack > stack) {
         if (pen->pos == start) { // empty match
-            for (int i=stack; i < pen->stack; i++) {
-                drop(pen->results[i]);
-            }
-            pen->stack = stack;            
-            return true; // TODO think about this, is it always correct? 
+            pen->stack = stack;
+            pen->arena->top = f->mark;
+            return; // TODO think about this, is it always correct? 
         }
         pen->multi++;
         Node* node = pen->results[stack];
         node->data_use = DATA_VALS;
         node->data.opx.is_multi = 1;
-        node->data.opx.multi = id2->data.opx.idx;
+        node->data.opx.multi = tag2;
     }
-    return result;
-}
-
-bool ext_and(Env* pen, Node* exp) { // <and x y>
-    if (exp->count != 3) return false;
-    return ext_and_ids(pen, exp->nodes[1], exp->nodes[2]);
 }
 
 // -- Prior match ---------------------------
@@ -925,15 +1204,19 @@ Node *find_prior(Env *pen, int tag) {
     return NULL;
 }
 
-bool ext_id(Env* pen, Node *id) { // <id x>  and @id
-    int tag = id->data.opx.idx;
+peg_pos prior_len(Env *pen, int tag) {
     Node *prior = find_prior(pen, tag);
-    int len = 0; // prior match length
+    if (prior == NULL) return 0;
+    return prior->end-prior->start;
+}
+
+bool ext_id(Env* pen, int tag) { // <id x>  and @id
+    Node *prior = find_prior(pen, tag);
+    peg_pos len = 0; // prior match length
     if (prior != NULL) len = prior->end-prior->start;
-    int size = prior->end - prior->start;
-    int start = pen->pos;
-    if (start+size > pen->end) return false;
-    for (int i=0; i<len; i++) {
+    peg_pos start = pen->pos;
+    if (start+len > pen->end) return false;
+    for (peg_pos i=0; i<len; i++) {
         if (pen->input[start+i] != pen->input[prior->start+i]) return false;
     }
     if (len == 0) return true;
@@ -944,24 +1227,10 @@ bool ext_id(Env* pen, Node *id) { // <id x>  and @id
     // return true;
 }
 
-bool ext_compare(Env* pen, Node* exp, int key) {
-    if (exp->count < 2) return false;
-    Node *id = exp->nodes[1];
-    int tag = id->data.opx.idx;
-    Node *prior = find_prior(pen, tag);
-    int len = 0; // prior match length
-    if (prior != NULL) len = prior->end-prior->start;           
-    int start = pen->pos;
-    int stack = pen->stack;
-    bool result = run(pen, id);
-    if (!result) return false;
-    int size = pen->pos - start;
-    if (pen->stack > stack) { // delete nodes...
-        for (int i=stack; i < pen->stack; i++) {
-            drop(pen->results[i]);
-        }
-        pen->stack = stack;
-    }
+// <eq x> etc compiled into:  CMP key x, CALL x, CMP_END
+// the x result nodes are deleted, and the match length compared
+
+bool ext_compare(int key, peg_pos size, peg_pos len) {
     if (key == EXT_eq) return size == len;
     if (key == EXT_lt) return size < len;
     if (key == EXT_gt) return size > len;
@@ -981,11 +1250,9 @@ void multi_transform(Env* pen, Node* parent) {
             pen->multi--;
             pen->pos = node->start;
             pen->end = node->end;
-            Node* rule = pen->tree->nodes[tag]->nodes[0];
             int stack = pen->stack;
-            bool result = run(pen, rule);
+            bool result = run(pen, tag);
             if (result && pen->pos == node->end) {
-                drop(parent->nodes[i]);
                 parent->nodes[i] = pen->results[stack--];
             }
         } else {
@@ -996,8 +1263,13 @@ void multi_transform(Env* pen, Node* parent) {
 
 // == bootstrap peg_code constructors =================================
 
+// The boot grammar ptree is made by boot_code() only in a PEG_BOOT_GEN
+// build (tools/boot-gen.c), that writes its compiled tables to pPEG-boot.h.
+
+#ifdef PEG_BOOT_GEN
+
 Node *ops(int tag, int n, ...) {
-    Node *nd = (Node *)malloc(sizeof(Node)+n*sizeof(Node *));
+    Node *nd = (Node *)calloc(1, sizeof(Node)+n*sizeof(Node *));
     if (nd == NULL) return NULL;
     nd->tag = tag; // rule name index
     nd->count = n;
@@ -1032,7 +1304,7 @@ int rule_index(const char *name) { // index of name in peg_names
 }
 
 Node *op(int tag, char *str) { // tag: ID, SQ, or CHS
-    Node *nd = (Node *)malloc(sizeof(Node));
+    Node *nd = (Node *)calloc(1, sizeof(Node));
     if (nd == NULL) return NULL;
     nd->tag = tag;
     nd->count = 0;
@@ -1053,7 +1325,7 @@ Node *op(int tag, char *str) { // tag: ID, SQ, or CHS
 }
 
 Node *opREP(Node *opx, char* sfx) { // rep(op, sfx)
-    Node *nd = (Node *)malloc(sizeof(Node)+2*sizeof(Node *));
+    Node *nd = (Node *)calloc(1, sizeof(Node)+2*sizeof(Node *));
     if (nd == NULL) return NULL;
     nd->tag = REP;
     nd->count = 2;
@@ -1069,7 +1341,7 @@ Node *opREP(Node *opx, char* sfx) { // rep(op, sfx)
 }
 
 Node *opPRE(char* pfx, Node* opx) {
-    Node *nd = (Node *)malloc(sizeof(Node)+2*sizeof(Node *));
+    Node *nd = (Node *)calloc(1, sizeof(Node)+2*sizeof(Node *));
     if (nd == NULL) return NULL;
     nd->tag = PRE;
     nd->count = 2;
@@ -1180,244 +1452,2114 @@ Node *boot_code() {
     );
 }
 
-// == Bootstrap ======================================
+#endif // PEG_BOOT_GEN
 
-Peg* BOOT = NULL;
+// == Compiler: grammar ptree => parser machine code ==================
 
-// BOOT = { peg_grammar, boot_code(), NULL};
-void bootstrap() {
-    Peg* peg = (Peg *)malloc(sizeof(Peg));
-    if (!peg) panic("boot malloc..");
-    peg->src = peg_grammar;
-    peg->tree = boot_code();
-    peg->peg = NULL;
-    peg->err = NULL;
-    BOOT = peg;
+typedef struct {
+    char* grammar;  // grammar source text
+    Node* tree;     // grammar ptree
+    Code* code;     // code being compiled
+    int max;        // ops capacity
+    int exp_max;    // exps capacity
+    int rule;       // index of the rule being compiled
+    int* calls;     // CALL sites, to be patched with rule entry pc
+    int call_count;
+    int call_max;
+    Node* undefined; // first undefined rule name, or NULL
+    int* alts;      // DISPATCH sites, to be filled with the first tables
+    int alt_count;
+    int alt_max;
+    char* inlining; // rule index => rule body is being inlined
+} Comp;
+
+void* grow(void* ptr, size_t size) {
+    ptr = realloc(ptr, size);
+    if (ptr == NULL) panic("realloc");
+    return ptr;
 }
 
-// == parser machine engine ==============================
+int emit(Comp* c, int x) { // append x to the code, returns its pc
+    Code* code = c->code;
+    if (code->len == c->max) {
+        c->max = c->max? c->max*2 : 256;
+        code->ops = grow(code->ops, c->max*sizeof(int));
+        code->fail = grow(code->fail, c->max*sizeof(int));
+        code->note = grow(code->note, c->max*sizeof(int));
+    }
+    int pc = code->len++;
+    code->ops[pc] = x;
+    code->fail[pc] = -1;
+    code->note[pc] = -1;
+    return pc;
+}
 
-bool run(Env *pen, Node *exp) {
-    if (pen->flags == 1) debug_trace(pen, exp);
-    switch (exp->tag) {
-    case ID: {
-        if (exp->data_use == NO_DATA) resolve_id(pen, exp);
-        if (exp->data_use == RANGE_DATA) return implicit_code(pen, exp);
-        if (exp->data_use == BUILTIN) return builtin(pen, exp);
-        int tag = exp->data.opx.idx;
-        int start = pen->pos;
-        int stack = pen->stack;
-        Node* rule = pen->tree->nodes[tag]->nodes[1];
-        if (pen->flags == 2) rule_trace_open(pen, tag);
-        if (pen->depth++ > MAX_STACK) panic("call recursion > MAX_STACK ....");
-        bool result = run(pen, rule);
-        pen->depth--;
-        if (pen->flags == 2) rule_trace_close(pen, tag, result);
-        if (pen->fail_rule < 0) pen->fail_rule = tag;
-        if (result) {
-            char first = pen->grammar[exp->start]; // tag name char
-            if (first == '_') return true;
-            int n = pen->stack-stack; // nodes count
-            if (n == 1 && first > 'Z') return true;
-            Node *nd = newNode(tag, start, pen->pos, n);
-            for (int i=0; i<n; i++) {
-                nd->nodes[i] = pen->results[stack+i];
-            };
-            pen->results[stack] = nd;
-            pen->stack = stack+1;
-            if (pen->stack >= MAX_STACK) { // TODO elastic stack...
-                panic("MAX_STACK exceeded...");
-            }
+int add_exp(Comp* c, Node* exp) { // returns index of exp in code exps
+    Code* code = c->code;
+    if (code->exp_count == c->exp_max) {
+        c->exp_max = c->exp_max? c->exp_max*2 : 64;
+        code->exps = grow(code->exps, c->exp_max*sizeof(Node*));
+        code->exp_rule = grow(code->exp_rule, c->exp_max*sizeof(int));
+    }
+    int i = code->exp_count++;
+    code->exps[i] = exp;
+    code->exp_rule[i] = c->rule;
+    return i;
+}
+
+// fail is the exps index of the seq element to report if the op fails
+
+int emit_op(Comp* c, int op, Node* exp, int fail) { // returns pc of op
+    int pc = emit(c, op);
+    if (exp) c->code->note[pc] = add_exp(c, exp);
+    c->code->fail[pc] = fail;
+    return pc;
+}
+
+int find_rule(Comp* c, Node* exp) { // index of rule named by exp, or -1
+    int len = exp->end - exp->start;
+    char* name = c->grammar + exp->start;
+    for (int i=0; i<c->tree->count; i++) {
+        Node* id = c->tree->nodes[i]->nodes[0];
+        if (id->end-id->start != len) continue;
+        if (strncmp(c->grammar+id->start, name, len) == 0) return i;
+    }
+    return -1;
+}
+
+void compile_call(Comp* c, Node* exp, int tag, int fail) {
+    emit_op(c, OP_CALL, exp, fail);
+    int site = emit(c, 0); // rule entry pc, patched when all rules are compiled
+    emit(c, tag);
+    if (c->call_count == c->call_max) {
+        c->call_max = c->call_max? c->call_max*2 : 64;
+        c->calls = grow(c->calls, c->call_max*sizeof(int));
+    }
+    c->calls[c->call_count++] = site;
+}
+
+// -- optimizer ----------------------------------------------------
+
+// The code is optimized as it is compiled, the parse trees are the same:
+// a call of a small _xyz rule (no node of its own) is replaced by the
+// rule body, nested (x / y) alternatives are flattened into one ALT, and
+// rules that the start rule can never reach are checked but not kept.
+// Inlined elements are still reported in their own rule, and the body
+// fails with the seq element of the call, as the call itself would.
+
+#define INLINE_MAX 24 // grammar ptree nodes in an inlined rule body
+
+int exp_size(Node* exp) {
+    int n = 1;
+    for (int i=0; i<exp->count; i++) n += exp_size(exp->nodes[i]);
+    return n;
+}
+
+int inline_rule(Comp* c, Node* exp) { // rule to inline for exp, or -1
+    int tag = find_rule(c, exp);
+    if (tag < 0 || c->code->mode[tag] != NODE_SKIP || c->inlining[tag]) return -1;
+    if (exp_size(c->tree->nodes[tag]->nodes[1]) > INLINE_MAX) return -1;
+    return tag;
+}
+
+void compile_exp(Comp* c, Node* exp, int fail);
+
+bool compile_inline(Comp* c, Node* exp, int fail) { // false if not inlined
+    int tag = inline_rule(c, exp);
+    if (tag < 0) return false;
+    int rule = c->rule;
+    c->rule = tag;
+    c->inlining[tag] = 1;
+    compile_exp(c, c->tree->nodes[tag]->nodes[1], fail);
+    c->inlining[tag] = 0;
+    c->rule = rule;
+    return true;
+}
+
+int alt_flat(Node* exp, Node** alts, int n) { // (x / y) / z => x / y / z
+    for (int i=0; i<exp->count; i++) {
+        Node* x = exp->nodes[i];
+        if (x->tag == ALT) {
+            n = alt_flat(x, alts, n);
+            continue;
         }
-        return result;
+        if (alts) alts[n] = x;
+        n += 1;
     }
-    case SEQ: {
-        int n = exp->count;
-        for (int i=0; i<n; i+=1) {
-            Node *op = exp->nodes[i];
-            if (!run(pen, op)) {
-                if (i>0 && pen->pos > pen->fail) {
-                    pen->fail = pen->pos;
-                    pen->fail_rule = -1; // flag for ID
-                    pen->expected = op;
-                }
-                return false;
-            }
+    return n;
+}
+
+void rule_uses(Comp* c, Node* exp, char* used) { // rules that exp may call
+    if (exp->tag == ID) {
+        int tag = find_rule(c, exp);
+        if (tag < 0 || used[tag]) return;
+        used[tag] = 1;
+        rule_uses(c, c->tree->nodes[tag]->nodes[1], used);
+        return;
+    }
+    for (int i=0; i<exp->count; i++) rule_uses(c, exp->nodes[i], used);
+}
+
+// -- char sets -----------------------------------------------------
+
+// A [xyz] char class, an _XX-YY implicit char rule, or an alternative
+// of these (and single char literals), or a ~ negation of one, is
+// compiled into a char set instruction:  SET n bits[8] ranges[2n]
+// Chars 0..255 are in the bitmap, larger chars in n sorted and merged
+// min..max ranges for a binary search.
+
+#define SET_MAX 0x7FFFFFFF
+
+typedef struct {
+    unsigned int bits[8]; // chars 0..255
+    int* ranges;          // min, max pairs for chars > 255
+    int count;            // ranges pairs
+    int max;              // ranges capacity
+} Set;
+
+void set_add(Set* set, int min, int max) {
+    for (; min <= max && min < 256; min++) {
+        set->bits[min>>5] |= 1u << (min&31);
+    }
+    if (min > max) return;
+    if (set->count == set->max) {
+        set->max = set->max? set->max*2 : 8;
+        set->ranges = grow(set->ranges, set->max*2*sizeof(int));
+    }
+    set->ranges[2*set->count] = min;
+    set->ranges[2*set->count+1] = max;
+    set->count += 1;
+}
+
+void set_sort(Set* set) { // sort and merge ranges
+    int* r = set->ranges;
+    for (int i=1; i<set->count; i++) { // insertion sort, few ranges
+        int min = r[2*i], max = r[2*i+1];
+        int j = i;
+        for (; j>0 && r[2*j-2] > min; j--) {
+            r[2*j] = r[2*j-2];
+            r[2*j+1] = r[2*j-1];
         }
-        return true;
+        r[2*j] = min;
+        r[2*j+1] = max;
     }
-    case ALT: {
-        int n = exp->count;
-        int pos = pen->pos;
-        int stack = pen->stack;
-        for (int i=0; i<n; i+=1) {
-            Node *op = exp->nodes[i];
-            if (run(pen, op)) return true;
-            if (pen->pos != pos) {
-                pen->pos = pos;
-            }
-            if (pen->stack > stack) {
-                for (int i=stack; i < pen->stack; i++) {
-                    drop(pen->results[i]);
-                }
-                pen->stack = stack;
-            }
+    int n = 0;
+    for (int i=0; i<set->count; i++) {
+        if (n > 0 && r[2*i] <= r[2*n-1]+1) {
+            if (r[2*i+1] > r[2*n-1]) r[2*n-1] = r[2*i+1];
+        } else {
+            r[2*n] = r[2*i];
+            r[2*n+1] = r[2*i+1];
+            n += 1;
         }
-        return false;
     }
-    case REP: {
-        if (exp->data_use == NO_DATA) resolve_rep(pen, exp);
-        Node *op = exp->nodes[0];
-        int min = exp->data.opx.min;
-        int max = exp->data.opx.max;
-        int pos = pen->pos;
-        int stack = pen->stack;
-        int count = 0;
-        do {
-            bool result = run(pen, op);
-            if (!result) break;
-            if (pen->pos == pos) break; // no progress
-            pos = pen->pos;
-            stack = pen->stack;
-            count += 1;
-        } while (count != max);
-        if (count < min) return false;
-        if (pen->pos > pos) {
-            pen->pos = pos; // reset last run failure
-        }
-        if (pen->stack > stack) {
-            for (int i=stack; i < pen->stack; i++) {
-                drop(pen->results[i]);
-            }
-            pen->stack = stack;
+    set->count = n;
+}
+
+void set_invert(Set* set) { // ~set
+    for (int i=0; i<8; i++) set->bits[i] = ~set->bits[i];
+    set_sort(set);
+    Set inv = { {0}, NULL, 0, 0 };
+    long min = 256;
+    for (int i=0; i<set->count; i++) {
+        if (set->ranges[2*i] > min) set_add(&inv, min, set->ranges[2*i]-1);
+        min = (long)set->ranges[2*i+1]+1;
+    }
+    if (min <= SET_MAX) set_add(&inv, min, SET_MAX);
+    free(set->ranges);
+    set->ranges = inv.ranges;
+    set->count = inv.count;
+    set->max = inv.max;
+}
+
+bool char_set(Comp* c, Node* exp, Set* set); 
+
+bool chs_set(Comp* c, Node* exp, Set* set) { // [xyz] with x-y ranges
+    int span = exp->end - exp->start;
+    int codes[span+1];
+    int len = node_ints(c->grammar, exp, codes);
+    for (int i=0; i<len; i++) {
+        if (i < len-2 && codes[i+1] == '-') {
+            set_add(set, codes[i], codes[i+2]);
+            i += 2;
+        } else {
+            set_add(set, codes[i], codes[i]);
         }
-        return true;
     }
-    case PRE: {
-        if (exp->data_use == NO_DATA) resolve_pre(pen, exp);
-        Node *op = exp->nodes[1];
-        char sign = exp->data.opx.sign;
-        int pos = pen->pos;
-        int stack = pen->stack;
-        bool result = run(pen, op);
-        pen->pos = pos; // reset
-        if (pen->stack > stack) {
-            for (int i=stack; i < pen->stack; i++) {
-                drop(pen->results[i]);
-            }
-            pen->stack = stack;
+    return true;
+}
+
+bool char_set(Comp* c, Node* exp, Set* set) { // false if exp is not a char set
+    switch (exp->tag) {
+    case CHS: return chs_set(c, exp, set);
+    case ID: {
+        int tag = find_rule(c, exp);
+        if (tag >= 0) { // a set in an inlined rule
+            if (inline_rule(c, exp) < 0) return false;
+            c->inlining[tag] = 1;
+            bool ok = char_set(c, c->tree->nodes[tag]->nodes[1], set);
+            c->inlining[tag] = 0;
+            return ok;
         }
-        if (sign == '~') {
-            if (result) return false;
-            if (pos < pen->end) {
-                pen->pos = pos+1; // UTF-8 continues ...
-                while ((pen->input[pen->pos] & 0xC0) == 0x80) pen->pos++;
-                return true;
-            }
-            return false;
+        char name[100];
+        char *p = node_text(c->grammar, exp, name, 100);
+        *p = '\0';
+        int range[2];
+        if (resolve_implicit(name, p-name, range) != _CHAR) return false;
+        set_add(set, range[0], range[1]);
+        return true;
+    }
+    case SQ: { // single char
+        int span = exp->end - exp->start;
+        int codes[span+1];
+        if (node_ints(c->grammar, exp, codes) != 1) return false;
+        int x = codes[0];
+        set_add(set, x, x);
+        if (c->grammar[exp->end+1] == 'i') { // 'x'i
+            int alts[4];
+            int n = case_alts(x, alts);
+            for (int i=0; i<n; i++) set_add(set, alts[i], alts[i]);
         }
-        if (sign == '!') return !result;
-        return result;
+        return true;
     }
-    case SQ: { 
-        if (exp->data_use == NO_DATA) resolve_sq(pen, exp);
-        unsigned char len = exp->data.str.chars[0];
-        if (pen->pos+len > pen->end) return false;
-        if (pen->grammar[exp->end+1] != 'i') { // normal case sensitive...
-            for (int i=1; i<=len; i+=1) {
-                if (pen->input[pen->pos] != exp->data.str.chars[i]) return false;
-                pen->pos += 1; // any bytes, so UTF-8 ok
-            }
-            return true;
-        } // 'xyz'i ASCII only case insensitive...  TODO Unicodes
-        for (int i=1; i<=len; i+=1) {
-            unsigned char c1 = pen->input[pen->pos];
-            if (c1 >= 'a' && c1 <= 'z') c1 = c1-32;
-            unsigned char c2 = exp->data.str.chars[i]; // TODO compile time..
-            if (c2 >= 'a' && c2 <= 'z') c2 = c2-32;
-            if (c1 != c2) return false;
-            pen->pos += 1;
+    case ALT: {
+        for (int i=0; i<exp->count; i++) {
+            if (!char_set(c, exp->nodes[i], set)) return false;
         }
         return true;
     }
-    case CHS: {
-        if (pen->pos >= pen->end) return false;
-        if (exp->data_use == NO_DATA) resolve_chs(pen, exp);
-        int len = exp->data.arr.ints[0];
-        int c = (unsigned char)pen->input[pen->pos];
-        int n = 1; // char size
-        if (c > 127) {
-            c = utf8_read(pen->input+pen->pos);
-            n = utf8_size(c);
-        }
-        for (int i=1; i<=len; i++) { // 1..len
-            int code = exp->data.arr.ints[i];
-            if (i<len-1 && exp->data.arr.ints[i+1] == '-') {
-                int max = exp->data.arr.ints[i+2];
-                i += 2;
-                if (c < code || c > max) continue;
-                pen->pos += n;
-                return true;
-            } else if (c == code) {
-                pen->pos += n;
-                return true;
+    case PRE: {
+        if (c->grammar[exp->nodes[0]->start] != '~') return false;
+        Set not = { {0}, NULL, 0, 0 };
+        bool ok = char_set(c, exp->nodes[1], &not);
+        if (ok) {
+            set_invert(&not);
+            for (int i=0; i<8; i++) set->bits[i] |= not.bits[i];
+            for (int i=0; i<not.count; i++) {
+                set_add(set, not.ranges[2*i], not.ranges[2*i+1]);
             }
         }
-        return false;
+        free(not.ranges);
+        return ok;
     }
-    case CALL: { // call = at? id _ ("->" id _)?
-        if (exp->count == 2 && exp->nodes[0]->tag == AT) { // @id
-            return ext_id(pen, exp->nodes[1]);
-        }
-        if (exp->count == 2 && exp->nodes[0]->tag == ID) { // id1 -> id2
-            Node* id1 = exp->nodes[0];
-            if (id1->data_use == NO_DATA) resolve_id(pen, id1);
-            Node* id2 = exp->nodes[1];
-            if (id2->data_use == NO_DATA) resolve_id(pen, id2);
-            return ext_and_ids(pen, id1, id2);
-        }
-        printf("*** Not implemented: "); // TODO improve err reporting
-        print_text(pen->grammar, exp);
-        printf("\n");
-        return false;
+    default: return false;
     }
-    case EXTN: {
-        if (exp->data_use == NO_DATA) resolve_extn(pen, exp);
-        int tag = exp->data.opx.idx;
-        switch (tag) {
-            case EXT_and:
-                return ext_and(pen, exp);
-            case EXT_id: {
-                if (exp->count < 2) return false;
-                return ext_id(pen, exp->nodes[1]);
-            }
-            case EXT_eq: case EXT_gt:  case EXT_ge:
-            case EXT_lt: case EXT_le: // TODO are these of any use?
-                return ext_compare(pen, exp, tag);
-            default: { // TODO better err reporting...
+}
+
+void emit_set(Comp* c, Set* set) { // n bits[8] ranges[2n]
+    set_sort(set);
+    emit(c, set->count);
+    for (int i=0; i<8; i++) emit(c, set->bits[i]);
+    for (int i=0; i<2*set->count; i++) emit(c, set->ranges[i]);
+}
+
+bool compile_set(Comp* c, Node* exp, int fail) { // false if not a char set
+    Set set = { {0}, NULL, 0, 0 };
+    if (!char_set(c, exp, &set)) {
+        free(set.ranges);
+        return false;
+    }
+    emit_op(c, OP_SET, exp, fail);
+    emit_set(c, &set);
+    free(set.ranges);
+    return true;
+}
+
+// A repeat of a char set is a span instruction, that scans the input
+// bytes without a loop through the REP frame. If the set is the same
+// for all bytes 80..FF (all UTF-8 chars, or none of them), then a byte
+// is in the set if it is in one of k <= 4 byte lo..hi ranges, or if
+// neg it is not in any of them. This byte test can be run 16 or 32
+// bytes at a time, otherwise k = -1 and the span decodes each char.
+
+int span_ranges(Set* set, bool member, int* lohi) { // byte ranges, or -1
+    int k = 0;
+    for (int b=0; b<256; b++) {
+        bool in = (set->bits[b>>5] >> (b&31)) & 1;
+        if (in != member) continue;
+        if (k > 0 && (lohi[k-1]>>8) == b-1) {
+            lohi[k-1] += 1<<8; // extend hi
+            continue;
+        }
+        if (k == 4) return -1;
+        lohi[k++] = b | b<<8;
+    }
+    return k;
+}
+
+void compile_span(Comp* c, Node* exp, int min, int max, Set* set, int fail) {
+    set_sort(set);
+    unsigned int hb = set->bits[4]; // chars 80..9F
+    bool ok = (hb == 0 || hb == ~0u) &&
+        set->bits[5] == hb && set->bits[6] == hb && set->bits[7] == hb;
+    bool high = hb != 0;
+    if (ok && high) ok = set->count == 1 && set->ranges[0] == 256 && set->ranges[1] == SET_MAX;
+    if (ok && !high) ok = set->count == 0;
+    int lohi[4];
+    int k = -1;
+    int neg = 0;
+    if (ok) {
+        k = span_ranges(set, true, lohi);
+        if (k < 0) {
+            k = span_ranges(set, false, lohi);
+            neg = 1;
+        }
+    }
+    emit_op(c, OP_SPAN, exp, fail);
+    emit(c, min);
+    emit(c, max);
+    emit(c, k);
+    emit(c, neg);
+    for (int i=0; i<k; i++) emit(c, lohi[i]);
+    emit_set(c, set);
+}
+
+void compile_bad(Comp* c, Node* exp, int err, int fail) {
+    if (err == BAD_RULE && !c->undefined) c->undefined = exp;
+    emit_op(c, OP_BAD, exp, fail);
+    emit(c, err);
+}
+
+void compile_id(Comp* c, Node* exp, int fail) {
+    int tag = find_rule(c, exp);
+    if (tag >= 0) {
+        compile_call(c, exp, tag, fail);
+        return;
+    }
+    if (compile_set(c, exp, fail)) return; // _XX-YY
+    char name[100];
+    char *p = node_text(c->grammar, exp, name, 100);
+    *p = '\0';
+    int range[2];
+    int imp = resolve_implicit(name, p-name, range);
+    if (imp != _NULL && imp != _CHAR) {
+        emit_op(c, OP_BUILTIN, exp, fail);
+        emit(c, imp);
+        return;
+    }
+    compile_bad(c, exp, BAD_RULE, fail);
+}
+
+void compile_seq(Comp* c, Node* exp, int fail) {
+    for (int i=0; i<exp->count; i+=1) {
+        Node* op = exp->nodes[i];
+        if (i > 0) fail = add_exp(c, op); // report op if it fails
+        compile_exp(c, op, fail);
+    }
+}
+
+//  DISPATCH.., CHOICE L1, alt, COMMIT L, L1: CHOICE L2, alt, COMMIT L, L2: ... FAIL, L:
+
+void compile_alt(Comp* c, Node* exp, Node** alts, int n, int fail) {
+    int commits[n];
+    if (n > 1 && n < 32) { // first byte dispatch, table filled in later
+        int m = n < 8? 1<<n : 256; // max distinct masks
+        int site = emit_op(c, OP_DISPATCH, exp, -1);
+        emit(c, m);
+        for (int i=0; i<2+64+m; i++) emit(c, 0);
+        if (c->alt_count == c->alt_max) {
+            c->alt_max = c->alt_max? c->alt_max*2 : 16;
+            c->alts = grow(c->alts, c->alt_max*sizeof(int));
+        }
+        c->alts[c->alt_count++] = site;
+    }
+    for (int i=0; i<n; i+=1) {
+        int choice = emit_op(c, OP_CHOICE, exp, -1);
+        emit(c, 0);
+        compile_exp(c, alts[i], -1);
+        commits[i] = emit_op(c, OP_COMMIT, NULL, -1);
+        emit(c, 0);
+        c->code->ops[choice+1] = c->code->len; // next alternative
+    }
+    emit_op(c, OP_FAIL, exp, fail); // all alternatives failed
+    for (int i=0; i<n; i+=1) {
+        c->code->ops[commits[i]+1] = c->code->len;
+    }
+}
+
+//  REP min max L, body, LOOP, L:
+
+void compile_rep(Comp* c, Node* exp, int fail) {
+    unsigned char max=0, min=0;
+    Node* sfx = exp->nodes[1];
+    if (sfx->tag == SFX) {
+        char sign = c->grammar[sfx->start];
+        if (sign == '+') min = 1;
+        if (sign == '?') max = 1;
+    } else if (sfx->tag == NUM) {
+        min = rep_num(c->grammar, sfx->start, sfx->end);
+        max = min;
+    } else if (sfx->tag == RANGE) { // range = num (dots num?)?
+        Node* num1 = sfx->nodes[0];
+        min = rep_num(c->grammar, num1->start, num1->end);
+        max = 0; // *Min..
+        if (sfx->count == 3) { // *Min..Max
+            Node* num2 = sfx->nodes[2];
+            max = rep_num(c->grammar, num2->start, num2->end);
+        }
+    } else panic("woops..");
+    Set set = { {0}, NULL, 0, 0 };
+    bool span = char_set(c, exp->nodes[0], &set);
+    if (span) compile_span(c, exp, min, max, &set, fail);
+    free(set.ranges);
+    if (span) return;
+    int rep = emit_op(c, OP_REP, exp, fail);
+    emit(c, min);
+    emit(c, max);
+    emit(c, 0);
+    compile_exp(c, exp->nodes[0], -1);
+    emit_op(c, OP_LOOP, NULL, fail);
+    c->code->ops[rep+3] = c->code->len;
+}
+
+//  PRE sign L, body, PEND, L:
+
+void compile_pre(Comp* c, Node* exp, int fail) {
+    Node* pfx = exp->nodes[0];
+    int pre = emit_op(c, OP_PRE, exp, fail);
+    emit(c, c->grammar[pfx->start]);
+    emit(c, 0);
+    compile_exp(c, exp->nodes[1], -1);
+    emit_op(c, OP_PEND, NULL, fail);
+    c->code->ops[pre+2] = c->code->len;
+}
+
+int sq_bytes(Comp* c, Node* exp, char* str) { // UTF-8 bytes of 'xyz'
+    int span = exp->end - exp->start;
+    int codes[span+1];
+    int len = node_ints(c->grammar, exp, codes);
+    bool icase = c->grammar[exp->end+1] == 'i'; // 'xyz'i folded
+    int n = 0;
+    for (int i=0; i<len; i++) {
+        n += utf8_write(str+n, icase? case_fold(codes[i]) : codes[i]);
+    }
+    return n;
+}
+
+void compile_sq(Comp* c, Node* exp, int fail) {
+    char str[4*(exp->end-exp->start)+4];
+    int n = sq_bytes(c, exp, str);
+    bool icase = c->grammar[exp->end+1] == 'i'; // 'xyz'i
+    emit_op(c, icase? OP_STRI : OP_STR, exp, fail);
+    emit(c, n);
+    for (int i=0; i<n; i+=4) { // pack bytes into ints
+        int x = 0;
+        memcpy(&x, str+i, n-i < 4? n-i : 4);
+        emit(c, x);
+    }
+}
+
+
+// -- literals trie -------------------------------------------------
+
+// An ALT of 'xyz' literals is matched in one pass over the input, with
+// a trie keyed on the upper case bytes ('xyz'i literals must be ASCII). Each trie node lists the
+// literals that end there, the first alternative that matches wins:
+//  TRIE size  nlits bytes root  lits[3*nlits] nodes..  literal bytes..
+// a literal is: byte offset, len, icase; a trie node is:
+//  nterms terms.. nedges (byte node)..   terms in alternative order
+
+typedef struct {
+    int* terms;    // literals ending here
+    int nterms;
+    int* edges;    // byte, child pairs
+    int nedges;
+} TrieNode;
+
+bool compile_trie(Comp* c, Node* exp, Node** alts, int n, int fail) {
+    if (n < 2) return false;
+    int size = 0; // literal bytes
+    for (int i=0; i<n; i++) {
+        if (alts[i]->tag != SQ) return false; // not all 'xyz'
+        size += 4*(alts[i]->end - alts[i]->start);
+    }
+    char bytes[size+4];
+    int lits[3*n];
+    int off = 0;
+    for (int i=0; i<n; i++) {
+        Node* sq = alts[i];
+        int len = sq_bytes(c, sq, bytes+off);
+        lits[3*i] = off;
+        lits[3*i+1] = len;
+        lits[3*i+2] = c->grammar[sq->end+1] == 'i';
+        for (int j=0; j<len; j++) { // the trie only folds ASCII
+            if (lits[3*i+2] && (unsigned char)bytes[off+j] >= 128) return false;
+        }
+        off += len;
+    }
+    TrieNode* nodes = calloc(size+1, sizeof(TrieNode)); // root + a node per byte
+    if (!nodes) panic("malloc..");
+    int count = 1; // nodes, root is node 0
+    for (int i=0; i<n; i++) {
+        int node = 0;
+        for (int j=0; j<lits[3*i+1]; j++) { // insert upper case bytes
+            int b = upper_case[(unsigned char)bytes[lits[3*i]+j]];
+            TrieNode* nd = &nodes[node];
+            int k = 0;
+            while (k < nd->nedges && nd->edges[2*k] != b) k++;
+            if (k == nd->nedges) {
+                nd->edges = grow(nd->edges, 2*(k+1)*sizeof(int));
+                nd->edges[2*k] = b;
+                nd->edges[2*k+1] = count++;
+                nd->nedges += 1;
+            }
+            node = nd->edges[2*k+1];
+        }
+        TrieNode* nd = &nodes[node];
+        nd->terms = grow(nd->terms, (nd->nterms+1)*sizeof(int));
+        nd->terms[nd->nterms++] = i;
+    }
+    int start = emit_op(c, OP_TRIE, exp, fail);
+    emit(c, 0); // size
+    int data = c->code->len;
+    emit(c, n);
+    int bytes_at = emit(c, 0);
+    emit(c, 0); // root
+    for (int i=0; i<3*n; i++) emit(c, lits[i]);
+    int at[count]; // node offsets
+    for (int i=0; i<count; i++) {
+        at[i] = c->code->len - data;
+        TrieNode* nd = &nodes[i];
+        emit(c, nd->nterms);
+        for (int j=0; j<nd->nterms; j++) emit(c, nd->terms[j]);
+        emit(c, nd->nedges);
+        for (int j=0; j<nd->nedges; j++) {
+            emit(c, nd->edges[2*j]);
+            emit(c, nd->edges[2*j+1]); // node index, patched below
+        }
+    }
+    for (int i=0; i<count; i++) { // node index => offset
+        int* nd = c->code->ops + data + at[i];
+        int* edges = nd+1+nd[0];
+        for (int j=0; j<edges[0]; j++) edges[2+2*j] = at[edges[2+2*j]];
+        free(nodes[i].terms);
+        free(nodes[i].edges);
+    }
+    free(nodes);
+    c->code->ops[bytes_at] = c->code->len - data;
+    c->code->ops[bytes_at+1] = at[0];
+    for (int i=0; i<off; i+=4) { // pack bytes into ints
+        int x = 0;
+        memcpy(&x, bytes+i, off-i < 4? off-i : 4);
+        emit(c, x);
+    }
+    c->code->ops[start+1] = c->code->len - data;
+    return true;
+}
+
+//  AND y, CALL x, AND_END
+
+void compile_and(Comp* c, Node* x, Node* y, int fail) {
+    int tag2 = find_rule(c, y);
+    if (tag2 < 0) {
+        compile_bad(c, y, BAD_RULE, fail);
+        return;
+    }
+    emit_op(c, OP_AND, y, fail);
+    emit(c, tag2);
+    compile_id(c, x, fail);
+    emit_op(c, OP_AND_END, NULL, fail);
+}
+
+void compile_extn(Comp* c, Node* exp, int fail) {
+    int key = extn_tag(c->grammar, exp);
+    for (int i=1; i<exp->count; i++) { // <cmd id-args...>
+        if (find_rule(c, exp->nodes[i]) < 0) {
+            compile_bad(c, exp->nodes[i], BAD_RULE, fail);
+            return;
+        }
+    }
+    switch (key) {
+        case EXT_and: {
+            if (exp->count != 3) break;
+            compile_and(c, exp->nodes[1], exp->nodes[2], fail);
+            return;
+        }
+        case EXT_id: {
+            if (exp->count < 2) break;
+            emit_op(c, OP_PRIOR, exp->nodes[1], fail);
+            emit(c, find_rule(c, exp->nodes[1]));
+            return;
+        }
+        case EXT_eq: case EXT_gt:  case EXT_ge:
+        case EXT_lt: case EXT_le: { // TODO are these of any use?
+            if (exp->count < 2) break;
+            Node* x = exp->nodes[1];
+            emit_op(c, OP_CMP, exp, fail);
+            emit(c, key);
+            emit(c, find_rule(c, x));
+            compile_id(c, x, fail);
+            emit_op(c, OP_CMP_END, NULL, fail);
+            return;
+        }
+        default: {
+            compile_bad(c, exp, BAD_EXTN, fail);
+            return;
+        }
+    }
+    emit_op(c, OP_FAIL, exp, fail); // wrong number of args
+}
+
+void compile_exp(Comp* c, Node* exp, int fail) {
+    switch (exp->tag) {
+    case ID: {
+        if (!compile_inline(c, exp, fail)) compile_id(c, exp, fail);
+        return;
+    }
+    case SEQ: compile_seq(c, exp, fail); return;
+    case ALT: {
+        if (compile_set(c, exp, fail)) return;
+        int n = alt_flat(exp, NULL, 0);
+        Node* alts[n];
+        alt_flat(exp, alts, 0);
+        if (compile_trie(c, exp, alts, n, fail)) return;
+        compile_alt(c, exp, alts, n, fail);
+        return;
+    }
+    case REP: compile_rep(c, exp, fail); return;
+    case PRE: {
+        if (!compile_set(c, exp, fail)) compile_pre(c, exp, fail);
+        return;
+    }
+    case SQ: compile_sq(c, exp, fail); return;
+    case CHS: compile_set(c, exp, fail); return;
+    case CALL: { // call = at? id _ ("->" id _)?
+        if (exp->count == 2 && exp->nodes[0]->tag == AT) { // @id
+            Node* id = exp->nodes[1];
+            int tag = find_rule(c, id);
+            if (tag < 0) {
+                compile_bad(c, id, BAD_RULE, fail);
+                return;
+            }
+            emit_op(c, OP_PRIOR, id, fail);
+            emit(c, tag);
+            return;
+        }
+        if (exp->count == 2 && exp->nodes[0]->tag == ID) { // id1 -> id2
+            compile_and(c, exp->nodes[0], exp->nodes[1], fail);
+            return;
+        }
+        compile_bad(c, exp, BAD_CALL, fail);
+        return;
+    }
+    case EXTN: compile_extn(c, exp, fail); return;
+    default: {
+        char msg[50];
+        sprintf(msg, "woops: undefined op: %d\n", exp->tag);
+        panic(msg);
+      }
+    }
+}
+
+// -- FIRST sets and ALT dispatch -----------------------------------
+
+// The first bytes that an expression can match, and if it can match
+// empty (null), are found from its compiled code. Each ALT has a table
+// that maps the next input byte to a mask of the alternatives that may
+// start with it, the parser skips the others. Extensions and builtins
+// are taken to match anything.
+
+typedef struct {
+    unsigned int bits[8]; // first bytes
+    bool null;            // may match empty
+} First;
+
+void first_any(First* f) {
+    for (int i=0; i<8; i++) f->bits[i] = ~0u;
+    f->null = true;
+}
+
+void first_byte(First* f, int b) {
+    f->bits[b>>5] |= 1u << (b&31);
+}
+
+void first_seq(Code* code, First* rules, int pc, int end, First* f);
+
+void first_op(Code* code, First* rules, int pc, First* f) { // one element
+    int* ops = code->ops;
+    memset(f, 0, sizeof(First));
+    switch (ops[pc]) {
+    case OP_CHOICE: { // alternatives, to the FAIL
+        while (ops[pc] == OP_CHOICE) {
+            int commit = ops[pc+1]-2;
+            First alt;
+            first_seq(code, rules, pc+2, commit, &alt);
+            for (int i=0; i<8; i++) f->bits[i] |= alt.bits[i];
+            if (alt.null) f->null = true;
+            pc = ops[pc+1];
+        }
+        return;
+    }
+    case OP_REP: {
+        first_seq(code, rules, pc+4, ops[pc+3]-1, f);
+        if (ops[pc+1] == 0) f->null = true;
+        return;
+    }
+    case OP_PRE: {
+        if (ops[pc+1] == '~') {
+            first_any(f);
+            f->null = false;
+        } else f->null = true; // !x &x
+        return;
+    }
+    case OP_CALL: *f = rules[ops[pc+2]]; return;
+    case OP_STR: case OP_STRI: {
+        if (ops[pc+1] == 0) {
+            f->null = true;
+            return;
+        }
+        char* str = (char*)(ops+pc+2);
+        first_byte(f, (unsigned char)str[0]);
+        if (ops[pc] == OP_STRI) { // the first byte of each case
+            int size, alts[4];
+            int n = case_alts(utf8_code(str, ops[pc+1], &size), alts);
+            for (int i=0; i<n; i++) {
+                char b[4];
+                utf8_write(b, alts[i]);
+                first_byte(f, (unsigned char)b[0]);
+            }
+        }
+        return;
+    }
+    case OP_SET: case OP_SPAN: {
+        int* set = ops+pc+1;
+        if (ops[pc] == OP_SPAN) {
+            int k = ops[pc+3] > 0? ops[pc+3] : 0;
+            set = ops+pc+5+k;
+            f->null = ops[pc+1] == 0;
+        }
+        for (int i=0; i<4; i++) f->bits[i] = set[1+i];
+        bool high = set[0] > 0; // any char > 127, any byte > 127
+        for (int i=4; i<8; i++) if (set[1+i]) high = true;
+        if (high) for (int i=4; i<8; i++) f->bits[i] = ~0u;
+        return;
+    }
+    case OP_TRIE: {
+        int* t = ops+pc+2;
+        int* root = t+t[2];
+        f->null = root[0] > 0; // '' literal
+        int* edges = root+1+root[0];
+        for (int j=0; j<edges[0]; j++) {
+            int b = edges[1+2*j];
+            first_byte(f, b);
+            if (b >= 'A' && b <= 'Z') first_byte(f, b+32);
+        }
+        return;
+    }
+    case OP_FAIL: return;
+    case OP_AND: case OP_AND_END: case OP_CMP_END: {
+        f->null = true;
+        return;
+    }
+    default: first_any(f); return; // BUILTIN, PRIOR, CMP, BAD
+    }
+}
+
+int first_next(int* ops, int pc) { // pc after the element at pc
+    if (ops[pc] == OP_CHOICE) {
+        while (ops[pc] == OP_CHOICE) pc = ops[pc+1];
+        return pc+1; // FAIL
+    }
+    if (ops[pc] == OP_REP) return ops[pc+3];
+    if (ops[pc] == OP_PRE) return ops[pc+2];
+    return pc + code_size(ops, pc);
+}
+
+void first_seq(Code* code, First* rules, int pc, int end, First* f) {
+    memset(f, 0, sizeof(First));
+    f->null = true;
+    while (pc < end && f->null) {
+        if (code->ops[pc] == OP_DISPATCH) {
+            pc += code_size(code->ops, pc);
+            continue;
+        }
+        First x;
+        first_op(code, rules, pc, &x);
+        for (int i=0; i<8; i++) f->bits[i] |= x.bits[i];
+        f->null = x.null;
+        pc = first_next(code->ops, pc);
+    }
+}
+
+void dispatch_tables(Comp* c) {
+    Code* code = c->code;
+    for (int pc=0; pc<code->len; pc+=code_size(code->ops, pc)) {
+        if (code->ops[pc] == OP_BAD) { // reports, must not run twice
+            for (int a=0; a<c->alt_count; a++) code->ops[c->alts[a]+2] = -1;
+            return;
+        }
+    }
+    int n = code->rule_count;
+    First* rules = calloc(n, sizeof(First));
+    if (!rules) panic("malloc..");
+    bool more = true;
+    while (more) { // to a fixed point...
+        more = false;
+        for (int i=0; i<n; i++) {
+            int end = i+1 < n? code->entry[i+1]-1 : code->len-1; // RET
+            First f;
+            first_seq(code, rules, code->entry[i], end, &f);
+            if (memcmp(&f, &rules[i], sizeof(First)) != 0) {
+                rules[i] = f;
+                more = true;
+            }
+        }
+    }
+    for (int a=0; a<c->alt_count; a++) {
+        int* ops = code->ops;
+        int site = c->alts[a];
+        int m = ops[site+1];
+        unsigned masks[256];
+        unsigned end = 0; // mask for the end of the input
+        int pc = site+4+64+m;
+        int k = 0;
+        for (; ops[pc] == OP_CHOICE; pc = ops[pc+1], k++) {
+            First alt;
+            first_seq(code, rules, pc+2, ops[pc+1]-2, &alt);
+            for (int b=0; b<256; b++) {
+                if (k == 0) masks[b] = 0;
+                if ((alt.bits[b>>5] >> (b&31)) & 1 || alt.null) masks[b] |= 1u<<k;
+            }
+            if (alt.null) end |= 1u<<k;
+        }
+        unsigned all = (1u<<k)-1; // k < 32
+        bool useful = false;
+        for (int b=0; b<256; b++) if (masks[b] != all) useful = true;
+        if (!useful) { // every alternative for every byte
+            ops[site+2] = -1;
+            continue;
+        }
+        ops[site+2] = pc; // FAIL
+        ops[site+3] = end;
+        unsigned char* map = (unsigned char*)(ops+site+4);
+        int count = 0; // distinct masks
+        for (int b=0; b<256; b++) {
+            int i = 0;
+            while (i < count && (unsigned)ops[site+68+i] != masks[b]) i++;
+            if (i == count) ops[site+68+count++] = masks[b];
+            map[b] = i;
+        }
+        code->dispatch = true;
+    }
+    free(rules);
+}
+
+// All rule names, literals and operands are resolved here, the code is
+// not changed by a parse. An undefined rule name is returned in `undefined`.
+
+Code* compile(char* grammar, Node* tree, Node** undefined) {
+    Code* code = calloc(1, sizeof(Code));
+    if (code == NULL) panic("malloc");
+    int n = tree->count; // rules
+    char inlining[n];
+    memset(inlining, 0, n);
+    Comp comp = { grammar, tree, code, 0, 0, 0, NULL, 0, 0, NULL, NULL, 0, 0, inlining };
+    Comp* c = &comp;
+    code->rule_count = n;
+    code->entry = malloc(n*sizeof(int));
+    code->mode = malloc(n);
+    code->memo = calloc(n, 1);
+    code->memo_limit = MEMO_LIMIT;
+    if (!code->entry || !code->mode || !code->memo) panic("malloc");
+    for (int i=0; i<n; i+=1) {
+        char first = grammar[tree->nodes[i]->nodes[0]->start]; // tag name char
+        code->mode[i] = NODE_KEEP;
+        if (first > 'Z') code->mode[i] = NODE_ELIDE;
+        if (first == '_') code->mode[i] = NODE_SKIP;
+    }
+    char used[n+1]; // rules reached from the start rule
+    memset(used, 0, n+1);
+    used[0] = 1;
+    rule_uses(c, tree->nodes[0]->nodes[1], used);
+    for (int i=0; i<n; i+=1) {
+        Node* rule = tree->nodes[i];
+        c->rule = i;
+        code->entry[i] = code->len;
+        int calls = c->call_count, alts = c->alt_count, exps = code->exp_count;
+        compile_exp(c, rule->nodes[1], -1);
+        if (!used[i]) { // unreachable, only checked
+            code->len = code->entry[i];
+            c->call_count = calls;
+            c->alt_count = alts;
+            code->exp_count = exps;
+        }
+        emit_op(c, OP_RET, rule->nodes[0], -1);
+    }
+    for (int i=0; i<c->call_count; i+=1) { // resolve rule entry pc
+        int site = c->calls[i];
+        code->ops[site] = code->entry[code->ops[site+1]];
+    }
+    free(c->calls);
+    dispatch_tables(c);
+    free(c->alts);
+    *undefined = c->undefined;
+    return code;
+}
+
+void code_free(Code* code) {
+    if (code->image) { // peg_load_compiled
+        free(code->exps);
+        free(code->profile);
+        munmap(code->image, code->image_size);
+        free(code);
+        return;
+    }
+    free(code->ops);
+    free(code->fail);
+    free(code->note);
+    free(code->exps);
+    free(code->exp_rule);
+    free(code->entry);
+    free(code->mode);
+    free(code->memo);
+    free(code->profile);
+    free(code);
+}
+
+// == Bootstrap ======================================
+
+// A compiled grammar is only read by the parser, all the state for a
+// parse is in its Env, so threads may parse with a shared grammar.
+// The BOOT grammar is static read-only tables, from pPEG-boot.h, so a
+// grammar compile has no bootstrap cost (and no allocation) before it.
+// A PEG_BOOT_GEN build makes BOOT by the first peg_compile instead.
+
+#ifdef PEG_BOOT_GEN
+
+#include <pthread.h>
+
+Peg* BOOT = NULL;
+pthread_once_t boot_once = PTHREAD_ONCE_INIT;
+
+// BOOT = { peg_grammar, boot_code(), NULL};
+void bootstrap() {
+    Peg* peg = (Peg *)malloc(sizeof(Peg));
+    if (!peg) panic("boot malloc..");
+    peg->src = peg_grammar;
+    peg->tree = boot_code();
+    peg->peg = NULL;
+    peg->err = NULL;
+    peg->arena = NULL;
+    peg->buf = NULL;
+    peg->map = 0;
+    peg->flat = NULL;
+    peg->flat_count = 0;
+    peg->flat_map = false;
+    Node* undefined = NULL;
+    peg->code = compile(peg->src, peg->tree, &undefined);
+    BOOT = peg;
+}
+
+#else
+
+#include "pPEG-boot.h" // generated by tools/boot-gen.c
+
+Peg* BOOT = (Peg*)&boot_peg;
+
+#endif // PEG_BOOT_GEN
+
+// == packrat memo ======================================
+
+// A memoized rule result is saved by (rule, pos): a success with its
+// result nodes, or a failure with its fail pos. Rules that match prior
+// sibling nodes (@x, <eq x> ...) depend on more than the pos.
+
+// The result nodes are moved to the memo arena (a backtrack may rewind the
+// tree arena), and shared from there by the parse tree and the memo hits,
+// so each node is copied once however deep the memoized rules are nested.
+// A result with x -> y nodes is copied for each hit, as multi_transform
+// changes the nodes in the tree.
+
+void rule_priors(Code* code, char* prior) { // rules using prior matches
+    int n = code->rule_count;
+    memset(prior, 0, n);
+    bool more = true;
+    while (more) { // until no more rules call a prior rule..
+        more = false;
+        for (int i=0; i<n; i++) {
+            if (prior[i]) continue;
+            int end = i+1 < n? code->entry[i+1] : code->len;
+            for (int pc=code->entry[i]; pc<end; pc+=code_size(code->ops, pc)) {
+                int op = code->ops[pc];
+                if (op == OP_PRIOR || op == OP_CMP ||
+                    (op == OP_CALL && prior[code->ops[pc+2]])) {
+                    prior[i] = 1;
+                    more = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+Node* copy_node(Arena* a, Node* node, int* multi, long* bytes) {
+    Node* nd = newNode(a, node->tag, node->start, node->end, node->count);
+    nd->data_use = node->data_use;
+    nd->data = node->data;
+    if (node->data_use == DATA_VALS && node->data.opx.is_multi) *multi += 1;
+    *bytes += sizeof(Node)+node->count*sizeof(Node*);
+    for (int i=0; i<node->count; i++) {
+        nd->nodes[i] = copy_node(a, node->nodes[i], multi, bytes);
+    }
+    return nd;
+}
+
+Node* memo_keep(Env *pen, Node* node, int* multi) { // node in the memo arena
+    if (node->memo) return node; // shared, and has no x -> y nodes
+    Node* nd = newNode(pen->memo_arena, node->tag, node->start, node->end, node->count);
+    nd->data_use = node->data_use;
+    nd->data = node->data;
+    nd->memo = 1;
+    if (node->data_use == DATA_VALS && node->data.opx.is_multi) *multi += 1;
+    pen->memo_bytes += sizeof(Node)+node->count*sizeof(Node*);
+    for (int i=0; i<node->count; i++) {
+        nd->nodes[i] = memo_keep(pen, node->nodes[i], multi);
+    }
+    return nd;
+}
+
+unsigned int memo_hash(int tag, peg_pos pos) {
+    return (unsigned int)pos*2654435761u + (unsigned int)tag*40503u;
+}
+
+Memo* memo_find(Env *pen, int tag, peg_pos pos) {
+    unsigned int mask = pen->memo_size-1;
+    unsigned int i = memo_hash(tag, pos) & mask;
+    while (pen->memo[i].tag >= 0) {
+        Memo* m = &pen->memo[i];
+        if (m->tag == tag && m->pos == pos) return m;
+        i = (i+1) & mask;
+    }
+    return NULL;
+}
+
+Memo* memo_slot(Env *pen, int tag, peg_pos pos) { // empty slot for (tag, pos)
+    unsigned int mask = pen->memo_size-1;
+    unsigned int i = memo_hash(tag, pos) & mask;
+    while (pen->memo[i].tag >= 0) i = (i+1) & mask;
+    return &pen->memo[i];
+}
+
+void memo_init(Env *pen, int size) {
+    pen->memo = malloc(size*sizeof(Memo));
+    if (!pen->memo) panic("malloc..");
+    for (int i=0; i<size; i++) pen->memo[i].tag = -1;
+    pen->memo_size = size;
+    pen->memo_count = 0;
+    pen->memo_bytes = size*sizeof(Memo);
+}
+
+bool memo_grow(Env *pen) { // double the table, within the memo limit
+    long bytes = pen->memo_bytes + pen->memo_size*sizeof(Memo);
+    if (bytes > pen->code->memo_limit) return false;
+    Memo* memo = pen->memo;
+    int size = pen->memo_size;
+    long used = pen->memo_bytes - size*sizeof(Memo);
+    int count = pen->memo_count;
+    memo_init(pen, size*2);
+    for (int i=0; i<size; i++) {
+        if (memo[i].tag < 0) continue;
+        *memo_slot(pen, memo[i].tag, memo[i].pos) = memo[i];
+    }
+    pen->memo_count = count;
+    pen->memo_bytes += used;
+    free(memo);
+    return true;
+}
+
+// save a rule result, stack is the results index at the rule start,
+// or -1 if the rule failed..
+
+void memo_store(Env *pen, int tag, peg_pos pos, int stack) {
+    if (pen->memo_bytes > pen->code->memo_limit) return; // memo full
+    if (2*(pen->memo_count+1) > pen->memo_size && !memo_grow(pen)) return;
+    if (memo_find(pen, tag, pos)) return;
+    Memo* m = memo_slot(pen, tag, pos);
+    m->tag = tag;
+    m->pos = pos;
+    m->end = pen->pos;
+    m->count = stack < 0? -1 : pen->stack-stack;
+    m->multi = 0;
+    m->nodes = NULL;
+    if (m->count > 0) {
+        m->nodes = arena_alloc(pen->memo_arena, m->count*sizeof(Node*));
+        pen->memo_bytes += m->count*sizeof(Node*);
+        for (int i=0; i<m->count; i++) {
+            m->nodes[i] = memo_keep(pen, pen->results[stack+i], &m->multi);
+        }
+        if (m->multi == 0) { // the tree shares the memo nodes
+            memcpy(pen->results+stack, m->nodes, m->count*sizeof(Node*));
+        }
+    }
+    pen->memo_count += 1;
+}
+
+void results_grow(Env *pen) { // spill results to the heap, or double it
+    int max = pen->results_max*2;
+    if (pen->results == pen->results_buf) {
+        pen->results = malloc(max*sizeof(Node*));
+        if (!pen->results) panic("malloc..");
+        memcpy(pen->results, pen->results_buf, pen->results_max*sizeof(Node*));
+    } else {
+        pen->results = grow(pen->results, max*sizeof(Node*));
+    }
+    pen->results_max = max;
+}
+
+bool memo_hit(Env *pen, Memo* m) { // replay a saved rule result
+    pen->pos = m->end;
+    if (m->count < 0) return false;
+    int multi = 0;
+    long bytes = 0;
+    for (int i=0; i<m->count; i++) {
+        if (pen->stack == pen->results_max) results_grow(pen);
+        Node* nd = m->nodes[i];
+        if (m->multi) nd = copy_node(pen->arena, nd, &multi, &bytes);
+        pen->results[pen->stack++] = nd;
+    }
+    pen->multi += m->multi;
+    return true;
+}
+
+void memo_free(Env *pen) {
+    arena_free(pen->memo_arena);
+    free(pen->memo);
+    pen->memo = NULL;
+}
+
+// == parser machine engine ==============================
+
+static inline void push(Env *pen, int kind, int site, int count) {
+    if (pen->top == pen->frame_max) {
+        pen->frame_max *= 2;
+        pen->frames = grow(pen->frames, pen->frame_max*sizeof(Frame));
+    }
+    Frame* f = &pen->frames[pen->top++];
+    f->kind = kind;
+    f->site = site;
+    f->pos = pen->pos;
+    f->stack = pen->stack;
+    f->count = count;
+    f->mark = pen->arena->top;
+}
+
+// -- profile mode ------------------------------------------------
+
+// The counters for a parse are in its Env, they are added to the grammar
+// counters when the parse ends, so threads may parse with a shared grammar.
+
+void profile_nodes(PegProfile* profile, Node* nd) { // nodes dropped
+    profile[nd->tag].dropped += 1;
+    for (int i=0; i<nd->count; i++) profile_nodes(profile, nd->nodes[i]);
+}
+
+void profile_drop(Env *pen, int stack) { // results above stack dropped
+    for (int i=stack; i<pen->stack; i++) profile_nodes(pen->profile, pen->results[i]);
+}
+
+void profile_ret(Env *pen, Frame* f) { // a rule has matched
+    PegProfile* p = &pen->profile[f->count];
+    p->calls += 1;
+    p->matches += 1;
+    p->bytes += pen->pos - f->pos;
+}
+
+void profile_fail(Env *pen, Frame* f, peg_pos at) { // a rule failed at pos
+    PegProfile* p = &pen->profile[f->count];
+    p->calls += 1;
+    p->fails += 1;
+    if (at > f->pos) p->backtrack += at - f->pos;
+}
+
+void profile_add(Env *pen) { // the parse counters to the grammar counters
+    long long* sum = (long long*)pen->code->profile;
+    long long* add = (long long*)pen->profile;
+    int n = pen->code->rule_count*sizeof(PegProfile)/sizeof(long long);
+    for (int i=0; i<n; i++) {
+        if (add[i]) __atomic_fetch_add(&sum[i], add[i], __ATOMIC_RELAXED);
+    }
+}
+
+PegProfile* profile_start(Peg* peg, int* count) {
+    Code* code = peg->code;
+    if (!code) return NULL;
+    if (!code->profile) {
+        code->profile = calloc(code->rule_count, sizeof(PegProfile));
+        if (!code->profile) panic("malloc..");
+    }
+    if (count) *count = code->rule_count;
+    return code->profile;
+}
+
+bool profile_before(PegProfile* p, int i, int j) { // most backtrack, then calls
+    if (p[i].backtrack != p[j].backtrack) return p[i].backtrack > p[j].backtrack;
+    if (p[i].calls != p[j].calls) return p[i].calls > p[j].calls;
+    return i < j;
+}
+
+void profile_print(Peg* peg) {
+    Code* code = peg->code;
+    if (!code || !code->profile) return;
+    int n = code->rule_count;
+    int order[n];
+    for (int i=0; i<n; i++) { // insertion sort, no shared state for threads
+        int k = i;
+        while (k > 0 && profile_before(code->profile, i, order[k-1])) {
+            order[k] = order[k-1];
+            k -= 1;
+        }
+        order[k] = i;
+    }
+    printf("%-16s %12s %12s %12s %12s %12s %12s %12s\n", "rule", "calls",
+        "matches", "fails", "bytes", "backtrack", "nodes", "dropped");
+    for (int k=0; k<n; k++) {
+        int i = order[k];
+        PegProfile* p = &code->profile[i];
+        if (p->calls == 0) continue;
+        Node* id = peg->tree->nodes[i]->nodes[0];
+        printf("%-16.*s %12lld %12lld %12lld %12lld %12lld %12lld %12lld\n",
+            (int)(id->end-id->start), peg->src+id->start, p->calls, p->matches,
+            p->fails, p->bytes, p->backtrack, p->nodes, p->dropped);
+    }
+}
+
+// -- heatmap mode ------------------------------------------------
+
+// A backtrack to f->pos will scan the input up to pos again, the first run
+// counts the rescans of each bucket of input, a second run records the
+// rule call stacks that rescan the hottest buckets.
+
+void heat_stack(Env *pen, Frame* f, int k) { // rule stack for top bucket k
+    Heat* h = pen->heat;
+    HeatStack s = { 0 };
+    Frame* top = pen->frames + h->failed; // the calls that failed, if any
+    if (top < f) top = f;
+    for (Frame* c=top-1; c>=pen->frames; c--) {
+        if (c->kind != F_CALL) continue;
+        if (s.depth == HEAT_DEPTH) {
+            s.deeper = true;
+            break;
+        }
+        s.tags[s.depth++] = c->count;
+    }
+    HeatStack* stacks = h->stacks[k];
+    for (int i=0; i<h->stack_count[k]; i++) {
+        HeatStack* t = &stacks[i];
+        if (t->depth == s.depth && t->deeper == s.deeper &&
+            memcmp(t->tags, s.tags, s.depth*sizeof(int)) == 0) {
+            t->count += 1;
+            return;
+        }
+    }
+    if (h->stack_count[k] == HEAT_STACKS) {
+        h->other[k] += 1;
+        return;
+    }
+    s.count = 1;
+    stacks[h->stack_count[k]++] = s;
+}
+
+void heat_add(Env *pen, Frame* f) { // input f->pos..pos will be scanned again
+    Heat* h = pen->heat;
+    int i = (f->pos - pen->start)/h->bucket;
+    int j = (pen->pos-1 - pen->start)/h->bucket;
+    if (!h->record) { // deltas, summed when the run ends
+        h->counts[i] += 1;
+        h->counts[j+1] -= 1;
+        return;
+    }
+    for (int k=0; k<h->top_count; k++) {
+        if (h->top[k] >= i && h->top[k] <= j) heat_stack(pen, f, k);
+    }
+    h->failed = 0;
+}
+
+void heat_top(Heat* h) { // sum the deltas, and find the hottest buckets
+    for (int i=1; i<h->size; i++) h->counts[i] += h->counts[i-1];
+    h->top_count = 0;
+    for (int i=0; i<h->size; i++) {
+        long long n = h->counts[i];
+        if (n == 0) continue;
+        int k = h->top_count;
+        if (k == HEAT_TOP && n <= h->counts[h->top[k-1]]) continue;
+        if (k < HEAT_TOP) h->top_count += 1;
+        else k -= 1; // drop the coolest
+        while (k > 0 && h->counts[h->top[k-1]] < n) {
+            h->top[k] = h->top[k-1];
+            k -= 1;
+        }
+        h->top[k] = i;
+    }
+    h->record = true;
+}
+
+int heat_cmp(const void* a, const void* b) { // most rescans first
+    long long x = ((HeatStack*)a)->count;
+    long long y = ((HeatStack*)b)->count;
+    return x < y? 1 : x > y? -1 : 0;
+}
+
+void heat_print(Env *pen) {
+    Heat* h = pen->heat;
+    long long total = 0;
+    int hot = 0;
+    for (int i=0; i<h->size; i++) {
+        total += h->counts[i];
+        if (h->counts[i]) hot += 1;
+    }
+    printf("rescans: %lld in %d of %d buckets of %d bytes\n",
+        total, hot, h->size-1, h->bucket);
+    for (int k=0; k<h->top_count; k++) {
+        int b = h->top[k];
+        peg_pos i = pen->start + (peg_pos)b*h->bucket;
+        peg_pos j = i + h->bucket;
+        if (j > pen->end) j = pen->end;
+        printf("\n%lld rescans of %lld..%lld on line: ", h->counts[b],
+            (long long)i, (long long)j);
+        print_line_num(pen->input, i);
+        printf("\n");
+        print_cursor(pen->input, i);
+        HeatStack* stacks = h->stacks[k];
+        qsort(stacks, h->stack_count[k], sizeof(HeatStack), heat_cmp);
+        for (int s=0; s<h->stack_count[k]; s++) {
+            printf("%12lld  %s", stacks[s].count, stacks[s].deeper? ".. " : "");
+            for (int d=stacks[s].depth-1; d>=0; d--) {
+                print_tag_name(pen, stacks[s].tags[d]);
+                printf(d? " " : "\n");
+            }
+            if (stacks[s].depth == 0) printf("\n");
+        }
+        if (h->other[k]) printf("%12lld  other rule stacks\n", h->other[k]);
+    }
+}
+
+static inline void drop_results(Env *pen, Frame* f) {
+    if (pen->profile) profile_drop(pen, f->stack);
+    pen->stack = f->stack;
+    pen->arena->top = f->mark;
+}
+
+static inline void reset(Env *pen, Frame* f) { // backtrack
+    if (pen->heat && pen->pos > f->pos) heat_add(pen, f);
+    pen->pos = f->pos;
+    drop_results(pen, f);
+}
+
+static inline bool in_set(int* set, int c) { // set: n bits[8] ranges[2n]
+    if (c < 256) return (set[1+(c>>5)] >> (c&31)) & 1;
+    int* r = set+9;
+    int lo = 0, hi = set[0]-1;
+    while (lo <= hi) { // binary search ranges
+        int mid = (lo+hi)/2;
+        if (c < r[2*mid]) hi = mid-1;
+        else if (c > r[2*mid+1]) lo = mid+1;
+        else return true;
+    }
+    return false;
+}
+
+// scan bytes in the span byte ranges: k neg lohi[k] set..
+// returns the pos of the first byte that is not in the span.
+
+static inline peg_pos span_scan(char* input, peg_pos pos, peg_pos end, int* span) {
+    int k = span[0];
+    int neg = span[1];
+    int* lohi = span+2;
+#ifdef __AVX2__
+    __m256i lo32[4], len32[4];
+    for (int i=0; i<k; i++) {
+        lo32[i] = _mm256_set1_epi8((char)(lohi[i] & 0xFF));
+        len32[i] = _mm256_set1_epi8((char)((lohi[i]>>8) - (lohi[i] & 0xFF)));
+    }
+    __m256i zero32 = _mm256_setzero_si256();
+    while (pos+32 <= end) {
+        __m256i b = _mm256_loadu_si256((__m256i*)(input+pos));
+        __m256i in = zero32;
+        for (int i=0; i<k; i++) { // lo <= b <= hi
+            __m256i d = _mm256_subs_epu8(_mm256_sub_epi8(b, lo32[i]), len32[i]);
+            in = _mm256_or_si256(in, _mm256_cmpeq_epi8(d, zero32));
+        }
+        unsigned int stop = (unsigned int)_mm256_movemask_epi8(in);
+        if (!neg) stop = ~stop;
+        if (stop) return pos + __builtin_ctz(stop);
+        pos += 32;
+    }
+#endif
+#ifdef __SSE2__
+    __m128i lo[4], len[4];
+    for (int i=0; i<k; i++) {
+        lo[i] = _mm_set1_epi8((char)(lohi[i] & 0xFF));
+        len[i] = _mm_set1_epi8((char)((lohi[i]>>8) - (lohi[i] & 0xFF)));
+    }
+    __m128i zero = _mm_setzero_si128();
+    while (pos+16 <= end) {
+        __m128i b = _mm_loadu_si128((__m128i*)(input+pos));
+        __m128i in = zero;
+        for (int i=0; i<k; i++) { // lo <= b <= hi
+            __m128i d = _mm_subs_epu8(_mm_sub_epi8(b, lo[i]), len[i]);
+            in = _mm_or_si128(in, _mm_cmpeq_epi8(d, zero));
+        }
+        unsigned int stop = (unsigned int)_mm_movemask_epi8(in);
+        if (!neg) stop = ~stop & 0xFFFF;
+        if (stop) return pos + __builtin_ctz(stop);
+        pos += 16;
+    }
+#endif
+    int* bits = span+2+k+1; // set bitmap
+    while (pos < end) {
+        int c = (unsigned char)input[pos];
+        if (!((bits[c>>5] >> (c&31)) & 1)) break;
+        pos += 1;
+    }
+    return pos;
+}
+
+static inline bool expect(Env *pen, int pc) { // a seq element failed at pc..
+    int i = pen->code->fail[pc];
+    if (i < 0) return false; // not a seq element
+    if (pen->pos > pen->fail) {
+        pen->fail = pen->pos;
+        pen->fail_rule = pen->code->exp_rule[i];
+        pen->expected = pen->code->exps[i];
+    }
+    return true;
+}
+
+void make_node(Env *pen, int tag, peg_pos start, int stack) { // rule result
+    int mode = pen->code->mode[tag];
+    if (mode == NODE_SKIP) return;
+    int n = pen->stack-stack; // nodes count
+    if (n == 1 && mode == NODE_ELIDE) return;
+    Node *nd = newNode(pen->arena, tag, start, pen->pos, n);
+    for (int i=0; i<n; i++) {
+        nd->nodes[i] = pen->results[stack+i];
+    };
+    if (pen->profile) pen->profile[tag].nodes += 1;
+    if (stack == pen->results_max) results_grow(pen); // n == 0
+    pen->results[stack] = nd;
+    pen->stack = stack+1;
+}
+
+// -- event mode -------------------------------------------------
+
+// A result is final when no backtrack frame (ALT, REP, PRE, MARK) can
+// drop it, ie it is below the stack of the first backtrack frame. The
+// calls below that frame will end, or the parse fails. They are sent an
+// enter event (if they will make a node), and the final results are sent
+// as a sequence of events. The sent results and their nodes are then
+// released, so the memory is only for the results that are not final.
+
+void events_tree(PegEvents* ev, Node* nd) {
+    if (nd->count == 0) {
+        if (ev->leaf) ev->leaf(ev->ctx, nd->tag, nd->start, nd->end);
+        return;
+    }
+    if (ev->enter) ev->enter(ev->ctx, nd->tag, nd->start);
+    for (int i=0; i<nd->count; i++) events_tree(ev, nd->nodes[i]);
+    if (ev->exit) ev->exit(ev->ctx, nd->tag, nd->start, nd->end);
+}
+
+void events_send(Env* pen, int stack) { // send the results below stack
+    while (pen->sent < stack) events_tree(pen->events, pen->results[pen->sent++]);
+}
+
+bool events_release(Code* code) { // the prior results may be needed..
+    for (int pc=0; pc<code->len; pc+=code_size(code->ops, pc)) {
+        int op = code->ops[pc];
+        if (op == OP_PRIOR || op == OP_AND || op == OP_CMP) return false;
+    }
+    return true;
+}
+
+void events_flush(Env* pen) { // send the final results
+    Frame* frames = pen->frames;
+    char* mode = pen->code->mode;
+    int i = pen->entered_count? pen->entered[pen->entered_count-1]+1 : 0;
+    int b = i; // first backtrack frame
+    while (b < pen->top && frames[b].kind == F_CALL) b++;
+    int limit = b < pen->top? frames[b].stack : pen->stack;
+    for (; i<b; i++) { // calls that will end
+        Frame* c = &frames[i];
+        if (mode[c->count] == NODE_SKIP) continue;
+        if (mode[c->count] == NODE_ELIDE) { // a node if not only one child
+            int j = i+1; // next call that will make one result
+            while (j < b && mode[frames[j].count] == NODE_SKIP) j++;
+            int kids = (j < b? frames[j].stack+1 : limit) - c->stack;
+            if (kids < 2) {
+                limit = c->stack;
+                break;
+            }
+        }
+        events_send(pen, c->stack);
+        if (pen->events->enter) pen->events->enter(pen->events->ctx, c->count, c->pos);
+        if (pen->entered_count == pen->entered_max) {
+            pen->entered_max = pen->entered_max? pen->entered_max*2 : 64;
+            pen->entered = grow(pen->entered, pen->entered_max*sizeof(int));
+        }
+        pen->entered[pen->entered_count++] = i;
+    }
+    events_send(pen, limit);
+    if (pen->sent == pen->stack) { // all sent, reuse the results and nodes
+        for (int k=0; k<pen->top; k++) frames[k].stack -= pen->sent;
+        pen->stack = 0;
+        pen->sent = 0;
+        pen->arena->top.block = -1; // a frame mark may be later, but
+        pen->arena->top.used = 0;   // its results are all dropped with it
+    }
+}
+
+void events_ret(Env* pen, Frame* f) { // rule result
+    int last = pen->entered_count? pen->entered[pen->entered_count-1] : -1;
+    if (pen->top == last) { // an entered call, all its results are final
+        events_send(pen, pen->stack);
+        PegEvents* ev = pen->events;
+        if (ev->exit) ev->exit(ev->ctx, f->count, f->pos, pen->pos);
+        pen->entered_count -= 1;
+    } else {
+        make_node(pen, f->count, f->pos, f->stack);
+    }
+    if (pen->top <= last+1) events_flush(pen); // else at an outer call end
+}
+
+// An instruction at pc has failed, pop the backtrack stack frames
+// to the first that can continue, returns its pc, or -1 if none.
+
+int backtrack(Env *pen, int pc, int base) {
+    int* ops = pen->code->ops;
+    bool done = expect(pen, pc); // only the inner-most seq is reported
+    peg_pos at = pen->pos;
+    if (pen->heat) pen->heat->failed = pen->top; // popped, but still there
+    while (pen->top > base) {
+        Frame* f = &pen->frames[--pen->top];
+        switch (f->kind) {
+        case F_CALL: {
+            pen->depth--;
+            if (pen->profile) profile_fail(pen, f, at);
+            if (pen->flags == 2) rule_trace_close(pen, f->count, false);
+            if (pen->memo && pen->code->memo[f->count]) {
+                memo_store(pen, f->count, f->pos, -1);
+            }
+            if (!done && f->site >= 0) done = expect(pen, f->site);
+            break;
+        }
+        case F_ALT: {
+            reset(pen, f);
+            int next = ops[f->site+1]; // next alternative, or FAIL
+            int mask = f->count; // dispatch alternatives, or -1
+            if (mask < 0) return next;
+            while (ops[next] == OP_CHOICE && !(mask & 1)) {
+                next = ops[next+1];
+                mask >>= 1;
+            }
+            if (ops[next] != OP_CHOICE) return next;
+            pen->top++; // keep this frame for the next alternative
+            f->site = next;
+            f->count = mask >> 1;
+            return next+2;
+        }
+        case F_REP: {
+            if (f->count < ops[f->site+1]) { // count < min
+                if (!done) done = expect(pen, f->site);
+                break;
+            }
+            reset(pen, f); // reset last run failure
+            return ops[f->site+3];
+        }
+        case F_PRE: {
+            reset(pen, f);
+            char sign = ops[f->site+1];
+            if (sign == '!') return ops[f->site+2];
+            if (sign == '~' && pen->pos < pen->end) {
+                pen->pos += 1; // UTF-8 continues ...
+                while ((pen->input[pen->pos] & 0xC0) == 0x80) pen->pos++;
+                return ops[f->site+2];
+            }
+            done = expect(pen, f->site); // pos reset
+            break;
+        }
+        case F_MARK: break;
+        }
+    }
+    if (pen->heat) pen->heat->failed = 0;
+    return -1;
+}
+
+// run the parser machine code for a rule...
+
+// When more input may follow, an instruction that needs to see past
+// the end suspends the run: the pc is saved, the pos is left at the
+// instruction start, and it is run again when the input has been fed.
+// A span keeps the chars it has matched, and goes on from the end.
+
+bool run(Env *pen, int rule) { // rule -1: resume a suspended run
+    int* ops = pen->code->ops;
+    int flags = pen->flags;
+    bool dispatch = pen->dispatch;
+    int base = pen->top;
+    int pc = pen->resume;
+    if (rule >= 0) {
+        if (flags == 2) rule_trace_open(pen, rule);
+        if (pen->depth++ > MAX_DEPTH) panic("call recursion > MAX_DEPTH ....");
+        push(pen, F_CALL, -1, rule);
+        pc = pen->code->entry[rule];
+    } else {
+        base = 0; // the start rule
+        pen->resume = -1;
+    }
+    for (;;) {
+        if (flags == 1) debug_trace(pen, pc);
+        switch (ops[pc]) {
+        case OP_CALL: {
+            int tag = ops[pc+2];
+            if (pen->memo && pen->code->memo[tag]) {
+                Memo* m = memo_find(pen, tag, pen->pos);
+                if (m) {
+                    if (!memo_hit(pen, m)) goto fail;
+                    pc += 3;
+                    continue;
+                }
+            }
+            if (flags == 2) rule_trace_open(pen, tag);
+            if (pen->depth++ > MAX_DEPTH) panic("call recursion > MAX_DEPTH ....");
+            push(pen, F_CALL, pc, tag);
+            pc = ops[pc+1];
+            continue;
+        }
+        case OP_RET: {
+            Frame* f = &pen->frames[--pen->top];
+            int tag = f->count;
+            pen->depth--;
+            if (flags == 2) rule_trace_close(pen, tag, true);
+            if (pen->profile) profile_ret(pen, f);
+            if (pen->release) events_ret(pen, f);
+            else make_node(pen, tag, f->pos, f->stack);
+            if (pen->memo && pen->code->memo[tag]) {
+                memo_store(pen, tag, f->pos, f->stack);
+            }
+            if (f->site < 0) return true;
+            pc = f->site+3;
+            continue;
+        }
+        case OP_DISPATCH: {
+            int first = pc+4+64+ops[pc+1]; // CHOICE of the first alternative
+            if (!dispatch || ops[pc+2] < 0) {
+                pc = first;
+                continue;
+            }
+            int mask = ops[pc+3];
+            if (pen->pos < pen->end) {
+                unsigned char* map = (unsigned char*)(ops+pc+4);
+                mask = ops[pc+68+map[(unsigned char)pen->input[pen->pos]]];
+            } else if (pen->more) goto suspend;
+            if (mask == 0) { // no alternative can match
+                pc = ops[pc+2]; // FAIL
+                continue;
+            }
+            pc = first;
+            while (!(mask & 1)) {
+                pc = ops[pc+1];
+                mask >>= 1;
+            }
+            push(pen, F_ALT, pc, mask >> 1);
+            pc += 2;
+            continue;
+        }
+        case OP_CHOICE: {
+            push(pen, F_ALT, pc, -1);
+            pc += 2;
+            continue;
+        }
+        case OP_COMMIT: {
+            pen->top--;
+            pc = ops[pc+1];
+            continue;
+        }
+        case OP_FAIL: goto fail;
+        case OP_REP: {
+            push(pen, F_REP, pc, 0);
+            pc += 4;
+            continue;
+        }
+        case OP_LOOP: {
+            Frame* f = &pen->frames[pen->top-1];
+            int rep = f->site; // REP min max L
+            if (pen->pos != f->pos) {
+                f->pos = pen->pos;
+                f->stack = pen->stack;
+                f->mark = pen->arena->top;
+                f->count += 1;
+                if (pen->release) events_flush(pen);
+                if (f->count != ops[rep+2]) { // count != max
+                    pc = rep+4;
+                    continue;
+                }
+            } else { // no progress
+                drop_results(pen, f);
+            }
+            pen->top--;
+            if (f->count < ops[rep+1]) { // count < min
+                pc = rep;
+                goto fail;
+            }
+            pc = ops[rep+3];
+            continue;
+        }
+        case OP_PRE: {
+            if (ops[pc+1] == '~' && pen->more && (pen->pos >= pen->end ||
+                pen->pos+utf8_len(pen->input+pen->pos) > pen->end)) goto suspend;
+            push(pen, F_PRE, pc, 0);
+            pc += 3;
+            continue;
+        }
+        case OP_PEND: {
+            Frame* f = &pen->frames[--pen->top];
+            reset(pen, f);
+            if (ops[f->site+1] == '&') {
+                pc += 1;
+                continue;
+            }
+            pc = f->site; // ~x or !x
+            goto fail;
+        }
+        case OP_STR: {
+            int len = ops[pc+1];
+            if (pen->pos+len > pen->end) {
+                if (pen->more) goto suspend;
+                goto fail;
+            }
+            char* str = (char*)(ops+pc+2);
+            for (int i=0; i<len; i+=1) {
+                if (pen->input[pen->pos] != str[i]) goto fail;
+                pen->pos += 1; // any bytes, so UTF-8 ok
+            }
+            pc += 2+(len+3)/4;
+            continue;
+        }
+        case OP_STRI: { // 'xyz'i case insensitive, str is upper case
+            int len = ops[pc+1];
+            if (pen->pos+len > pen->end) {
+                if (pen->more) goto suspend;
+                goto fail;
+            }
+            unsigned char* str = (unsigned char*)(ops+pc+2);
+            unsigned char* s = (unsigned char*)pen->input+pen->pos;
+            int i = 0;
+            while (i < len) {
+                if (str[i] < 128) { // ASCII fold
+                    if (upper_case[s[i]] != str[i]) break;
+                    i += 1;
+                    continue;
+                }
+                int n, m; // a fold keeps the UTF-8 length
+                int x = utf8_code((char*)str+i, len-i, &n);
+                int y = utf8_code((char*)s+i, len-i, &m);
+                if (n != m || case_fold(y) != x) break;
+                i += n;
+            }
+            pen->pos += i;
+            if (i < len) goto fail;
+            pc += 2+(len+3)/4;
+            continue;
+        }
+        case OP_TRIE: {
+            int* t = ops+pc+2; // nlits bytes root lits.. nodes.. bytes..
+            char* bytes = (char*)(t+t[1]);
+            int* node = t+t[2];
+            int best = -1; // first alternative that matches
+            int len = 0;
+            for (peg_pos i=pen->pos; ; i++) {
+                for (int j=1; j<=node[0]; j++) { // literals ending here
+                    int lit = node[j];
+                    if (best >= 0 && lit > best) break;
+                    int* l = t+3+3*lit; // byte offset, len, icase
+                    if (l[2] || memcmp(bytes+l[0], pen->input+pen->pos, l[1]) == 0) {
+                        best = lit;
+                        len = l[1];
+                        break;
+                    }
+                }
+                if (best == 0) break;
+                if (i >= pen->end) {
+                    if (pen->more && node[1+node[0]] > 0) goto suspend; // edges
+                    break;
+                }
+                int b = upper_case[(unsigned char)pen->input[i]];
+                int* edges = node+1+node[0];
+                int k = 0;
+                while (k < edges[0] && edges[1+2*k] != b) k++;
+                if (k == edges[0]) break;
+                node = t+edges[2+2*k];
+            }
+            if (best < 0) goto fail;
+            pen->pos += len;
+            pc += 2+ops[pc+1];
+            continue;
+        }
+        case OP_SET: {
+            if (pen->pos >= pen->end) {
+                if (pen->more) goto suspend;
+                goto fail;
+            }
+            int c = (unsigned char)pen->input[pen->pos];
+            int n = 1; // char size
+            if (c > 127) {
+                if (pen->more && pen->pos+utf8_len(pen->input+pen->pos) > pen->end) {
+                    goto suspend;
+                }
+                c = utf8_code(pen->input+pen->pos, pen->end-pen->pos, &n);
+            }
+            if (!in_set(ops+pc+1, c)) goto fail;
+            pen->pos += n;
+            pc += 10+2*ops[pc+1];
+            continue;
+        }
+        case OP_SPAN: {
+            int min = ops[pc+1];
+            int max = ops[pc+2];
+            int k = ops[pc+3];
+            int* set = ops+pc+5+(k > 0? k : 0);
+            int count = 0;
+            peg_pos start = pen->pos;
+            if (pen->span_count >= 0) { // resume at the end of the last input
+                start = pen->span_start;
+                count = pen->span_count;
+                pen->span_count = -1;
+            }
+            if (k >= 0 && min <= 1 && max == 0) { // no need to count chars
+                pen->pos = span_scan(pen->input, pen->pos, pen->end, ops+pc+3);
+                count = pen->pos > start;
+                if (pen->more && pen->pos == pen->end) goto span_suspend;
+            } else {
+                while (max == 0 || count < max) {
+                    if (pen->pos >= pen->end) {
+                        if (!pen->more) break;
+                        goto span_suspend;
+                    }
+                    int c = (unsigned char)pen->input[pen->pos];
+                    int n = 1;
+                    if (c > 127) {
+                        if (pen->more && pen->pos+utf8_len(pen->input+pen->pos) > pen->end) {
+                            goto span_suspend;
+                        }
+                        c = utf8_code(pen->input+pen->pos, pen->end-pen->pos, &n);
+                    }
+                    if (!in_set(set, c)) break;
+                    pen->pos += n;
+                    count += 1;
+                }
+            }
+            if (count < min) goto fail;
+            pc = set-ops+9+2*set[0];
+            continue;
+          span_suspend:
+            pen->span_start = start;
+            pen->span_count = count;
+            goto suspend;
+        }
+        case OP_BUILTIN: { // looks at most 2 bytes ahead, but _ may match more
+            peg_pos start = pen->pos;
+            if (pen->more && pen->pos+2 > pen->end) goto suspend;
+            if (!builtin(pen, ops[pc+1])) goto fail;
+            if (pen->more && pen->pos == pen->end) {
+                pen->pos = start;
+                goto suspend;
+            }
+            pc += 2;
+            continue;
+        }
+        case OP_PRIOR: {
+            if (pen->more && pen->pos+prior_len(pen, ops[pc+1]) > pen->end) {
+                goto suspend;
+            }
+            if (!ext_id(pen, ops[pc+1])) goto fail;
+            pc += 2;
+            continue;
+        }
+        case OP_AND: {
+            push(pen, F_MARK, pc, 0);
+            pc += 2;
+            continue;
+        }
+        case OP_AND_END: {
+            Frame* f = &pen->frames[--pen->top];
+            ext_and_end(pen, f, ops[f->site+1]);
+            pc += 1;
+            continue;
+        }
+        case OP_CMP: {
+            push(pen, F_MARK, pc, 0);
+            pc += 3;
+            continue;
+        }
+        case OP_CMP_END: { // the prior is found again, with x results dropped
+            Frame* f = &pen->frames[--pen->top];
+            peg_pos size = pen->pos - f->pos;
+            drop_results(pen, f);
+            peg_pos len = prior_len(pen, ops[f->site+2]);
+            if (!ext_compare(ops[f->site+1], size, len)) goto fail;
+            pc += 1;
+            continue;
+        }
+        case OP_BAD: {
+            Node* exp = pen->code->exps[pen->code->note[pc]];
+            if (ops[pc+1] == BAD_CALL) {
+                printf("*** Not implemented: "); // TODO improve err reporting
+            } else { // TODO better err reporting...
                 printf("**** Undefined extn: ");
-                print_text(pen->grammar, exp);
-                printf("\n");
-                return false;
             }
+            print_text(pen->grammar, exp);
+            printf("\n");
+            goto fail;
         }
-        return false;     
-    }   
-    default: {
-        char msg[50];
-        sprintf(msg, "woops: undefined op: %d\n", exp->tag);
-        panic(msg);
-        return false;
-      }
-    } // switch
+        default: {
+            char msg[50];
+            sprintf(msg, "woops: undefined op: %d\n", ops[pc]);
+            panic(msg);
+          }
+        } // switch
+      fail:
+        pc = backtrack(pen, pc, base);
+        if (pc < 0) return false;
+    }
+  suspend:
+    pen->resume = pc;
+    return false;
 } // run
 
 
 // ==  Parser  ============================================
 
-Peg* peg_parser(Peg* peg, char* input, int start, int end, int flags) {
+bool parse(Env *pen) { // run the start rule from the start
+    pen->pos = pen->start;
+    pen->span_count = -1;
+    pen->depth = 0;
+    pen->stack = 0;
+    pen->top = 0;
+    pen->arena->top.block = -1;
+    pen->arena->top.used = 0;
+    pen->sent = 0;
+    pen->entered_count = 0;
+    for (int i=0; i<pen->code->rule_count; i++) {
+        if (pen->code->memo[i] && !pen->release) {
+            pen->memo_arena = newArena();
+            memo_init(pen, 1024);
+            break;
+        }
+    }
+    pen->multi = 0;
+    pen->trace_pos = pen->start;
+    pen->trace_depth = 0;
+    pen->trace_open = true;
+    pen->fail = 0;
+    pen->fail_rule = 0;
+    pen->expected = NULL;
+    if (pen->profile) { // counts for the last run (a fault report runs again)
+        memset(pen->profile, 0, pen->code->rule_count*sizeof(PegProfile));
+    }
+    if (pen->code->run && !pen->flags && !pen->more && !pen->profile && !pen->heat) {
+        // peg_gen_c parser
+        return pen->code->run(pen, 0);
+    }
+    return run(pen, 0); // <rule.0>
+}
+
+void env_free(Env *pen) {
+    if (pen->profile) profile_add(pen);
+    free(pen->profile);
+    free(pen->frames);
+    free(pen->entered);
+    if (pen->results != pen->results_buf) free(pen->results);
+}
+
+void env_init(Env *pen, Peg* peg, char* input, peg_pos start, peg_pos end, int flags) {
+    pen->grammar = peg->src;
+    pen->tree = peg->tree;
+    pen->code = peg->code;
+    pen->input = input;
+    pen->start = start;
+    pen->pos = start;
+    pen->end = end; //strlen(input);
+    pen->more = false;
+    pen->resume = -1;
+    pen->span_count = -1;
+    pen->depth = 0;
+    pen->stack = 0;
+    pen->results = pen->results_buf;
+    pen->results_max = RESULTS_INLINE;
+    pen->top = 0;
+    pen->frame_max = 64;
+    pen->frames = malloc(pen->frame_max*sizeof(Frame));
+    if (!pen->frames) panic("malloc..");
+    pen->arena = newArena();
+    pen->memo = NULL;
+    pen->events = NULL;
+    pen->release = false;
+    pen->sent = 0;
+    pen->entered = NULL;
+    pen->entered_count = 0;
+    pen->entered_max = 0;
+    pen->profile = NULL;
+    if (peg->code->profile) {
+        pen->profile = calloc(peg->code->rule_count, sizeof(PegProfile));
+        if (!pen->profile) panic("malloc..");
+    }
+    pen->heat = NULL;
+    pen->flags = flags;
+    pen->dispatch = peg->code->dispatch && !flags;
+}
+
+Peg* parse_result(Peg* peg, Env *pen, bool result) { // parse tree or error
+    char* input = pen->input;
+    if (pen->dispatch && (!result || pen->pos != pen->end)) {
+        // the dispatch skips alternatives that can not match, but
+        // they may set the expected fault report, so run it again
+        if (pen->memo) memo_free(pen);
+        pen->dispatch = false;
+        result = parse(pen);
+    }
+
+    if (pen->flags) printf("\n\n"); // end of debug trace
+
+    if (pen->memo) { // x -> y runs rules on sub-spans
+        if (result) { // the tree shares the memo nodes
+            pen->arena->more = pen->memo_arena;
+            pen->memo_arena = NULL;
+        }
+        memo_free(pen);
+    }
+
+    if (result) {
+        Peg* new_peg = newPeg(input, pen->results[0], peg, NULL);
+        new_peg->arena = pen->arena;
+        if (pen->pos == pen->end) { // OK ...
+            while (pen->multi) {
+                multi_transform(pen, pen->results[0]);
+            }
+            arena_trim(pen->arena);
+            env_free(pen);
+            return new_peg;
+        }
+        new_peg->err = newErr(PEG_FELL_SHORT, pen->pos > pen->fail? pen->pos : pen->fail);
+        arena_trim(pen->arena);
+        env_free(pen);
+        return new_peg;
+    }
+
+    Err* err = newErr(PEG_FAILED, pen->pos > pen->fail? pen->pos : pen->fail);
+    err->fail_rule = pen->fail_rule;
+    err->expected = pen->expected;
+    Peg* bad_peg = newPeg(input, NULL, peg, err);
+
+    arena_free(pen->arena);
+    env_free(pen);
+    return bad_peg;
+}
+
+Peg* peg_parser(Peg* peg, char* input, peg_pos start, peg_pos end, int flags) {
     if (!peg) { // peg_compile(BOOT, ...)
-        if (!BOOT) bootstrap();
+#ifdef PEG_BOOT_GEN
+        pthread_once(&boot_once, bootstrap);
+#endif
         peg = BOOT;
     }
     if (peg->err) {
@@ -1425,59 +3567,1036 @@ Peg* peg_parser(Peg* peg, char* input, int start, int end, int flags) {
         panic("grammar error...");
     }
     Env pen;
-    pen.grammar = peg->src;
-    pen.tree = peg->tree;
-    pen.input = input;
-    pen.start = start;
-    pen.pos = start;
-    pen.end = end; //strlen(input);
-    pen.depth = 0;
-    pen.stack = 0;
-    pen.multi = 0;
-    pen.flags = flags;
-    pen.trace_pos = start;
-    pen.trace_depth = 0;
-    pen.trace_open = true;
-    pen.fail = 0;
-    pen.fail_rule = 0;
-    pen.expected = NULL;
-
-    Node* begin = pen.tree->nodes[0]->nodes[0]; // op(ID, <rule.0>)
-
-    bool result = run(&pen, begin);
-
-    if (pen.flags) printf("\n\n"); // end of debug trace
+    env_init(&pen, peg, input, start, end, flags);
+    bool result = parse(&pen);
+    return parse_result(peg, &pen, result);
+}
 
-    if (result) {
-        Peg* new_peg = newPeg(input, pen.results[0], peg, NULL);
-        if (pen.pos == pen.end) { // OK ...
-            while (pen.multi) {
-                multi_transform(&pen, pen.results[0]);
+// heatmap mode: count the input rescans, then run again for the rule stacks..
+
+Peg* heat_parser(Peg* peg, char* input, peg_pos start, peg_pos end, int bucket) {
+    if (peg->err) {
+        fault_report(peg);
+        panic("grammar error...");
+    }
+    Heat* heat = calloc(1, sizeof(Heat));
+    if (!heat) panic("malloc..");
+    heat->bucket = bucket > 0? bucket : HEAT_BUCKET;
+    heat->size = (end-start)/heat->bucket + 2; // +1 for the last delta
+    heat->counts = calloc(heat->size, sizeof(long long));
+    if (!heat->counts) panic("malloc..");
+    Env pen;
+    env_init(&pen, peg, input, start, end, 0);
+    pen.heat = heat;
+    parse(&pen);
+    heat_top(heat);
+    if (pen.memo) memo_free(&pen);
+    bool result = parse(&pen); // the same run, to record the stacks
+    heat_print(&pen);
+    pen.heat = NULL;
+    free(heat->counts);
+    free(heat);
+    return parse_result(peg, &pen, result);
+}
+
+// event mode: the tree is sent to the event callbacks, and not kept..
+
+Peg* events_parser(Peg* peg, char* input, peg_pos start, peg_pos end, PegEvents* events) {
+    if (peg->err) {
+        fault_report(peg);
+        panic("grammar error...");
+    }
+    Env pen;
+    env_init(&pen, peg, input, start, end, 0);
+    pen.events = events;
+    pen.release = events_release(peg->code);
+    bool result = parse(&pen);
+    if (result && pen.pos == pen.end) {
+        while (pen.multi) multi_transform(&pen, pen.results[0]);
+        events_send(&pen, pen.stack);
+        if (pen.memo) memo_free(&pen);
+        arena_free(pen.arena);
+        env_free(&pen);
+        return newPeg(input, NULL, peg, NULL);
+    }
+    PegEvents quiet = { NULL, NULL, NULL, NULL };
+    pen.events = &quiet; // run it again for the fault report
+    pen.dispatch = false;
+    if (pen.memo) memo_free(&pen);
+    result = parse(&pen);
+    Err* err = newErr(result? PEG_FELL_SHORT : PEG_FAILED, pen.pos > pen.fail? pen.pos : pen.fail);
+    if (!result) {
+        err->fail_rule = pen.fail_rule;
+        err->expected = pen.expected;
+    }
+    if (pen.memo) memo_free(&pen);
+    arena_free(pen.arena);
+    env_free(&pen);
+    return newPeg(input, NULL, peg, err);
+}
+
+// == Push parser =========================================
+
+// The input is fed in chunks, and the parse runs as far as it can with
+// each one. The input is kept (a parse may backtrack to any pos, and
+// the tree refers to it), and it is owned by the tree from peg_finish.
+
+struct PegFeed {
+    Peg* peg;     // grammar
+    Env pen;      // suspended parse
+    char* buf;    // input so far, with a 0 end
+    size_t max;   // buf capacity
+    bool done;    // the start rule has ended, more input can not help
+    bool result;
+};
+
+PegFeed* feed_start(Peg* peg) {
+    if (peg->err) {
+        fault_report(peg);
+        panic("grammar error...");
+    }
+    PegFeed* ctx = malloc(sizeof(PegFeed));
+    if (!ctx) panic("malloc..");
+    ctx->peg = peg;
+    ctx->max = 4096;
+    ctx->buf = malloc(ctx->max);
+    if (!ctx->buf) panic("malloc..");
+    ctx->buf[0] = 0;
+    env_init(&ctx->pen, peg, ctx->buf, 0, 0, 0);
+    ctx->pen.more = true;
+    ctx->result = parse(&ctx->pen);
+    ctx->done = ctx->pen.resume < 0;
+    return ctx;
+}
+
+bool feed(PegFeed* ctx, char* input, size_t len) {
+    Env* pen = &ctx->pen;
+    size_t max = (1ULL << (sizeof(peg_pos)*8-1)) - 1;
+    if (len >= max-pen->end) panic("input too large, build with -DPEG_POS64..");
+    if (pen->end+len+1 > ctx->max) {
+        while (pen->end+len+1 > ctx->max) ctx->max *= 2;
+        ctx->buf = grow(ctx->buf, ctx->max);
+        pen->input = ctx->buf;
+    }
+    memcpy(ctx->buf+pen->end, input, len);
+    pen->end += len;
+    ctx->buf[pen->end] = 0;
+    if (ctx->done) return false;
+    ctx->result = run(pen, -1);
+    ctx->done = pen->resume < 0;
+    return !ctx->done;
+}
+
+Peg* feed_finish(PegFeed* ctx) {
+    Env* pen = &ctx->pen;
+    pen->more = false;
+    if (!ctx->done) ctx->result = run(pen, -1);
+    Peg* tree = parse_result(ctx->peg, pen, ctx->result);
+    tree->buf = ctx->buf;
+    free(ctx);
+    return tree;
+}
+
+// == Flat tree ===========================================
+
+// The parse tree copied into one array of nodes in pre-order, the
+// children of node i start at i+1, and its next sibling is at i+size.
+// A tree walk is then a scan of the array, with no pointers to chase.
+
+int flat_size(Node* nd) {
+    int size = 1;
+    for (int i=0; i<nd->count; i++) size += flat_size(nd->nodes[i]);
+    return size;
+}
+
+int flat_fill(PegFlat* flat, int i, Node* nd) {
+    PegFlat* fl = flat+i;
+    fl->start = nd->start;
+    fl->end = nd->end;
+    fl->tag = nd->tag;
+    int k = i+1;
+    for (int j=0; j<nd->count; j++) k = flat_fill(flat, k, nd->nodes[j]);
+    fl->size = k-i;
+    return k;
+}
+
+PegFlat* flat_tree(Peg* peg, int* count) {
+    if (!peg->flat && peg->tree && !peg->code) { // a parse tree, not a grammar
+        int n = flat_size(peg->tree);
+        peg->flat = malloc(n*sizeof(PegFlat));
+        if (!peg->flat) panic("malloc..");
+        flat_fill(peg->flat, 0, peg->tree);
+        peg->flat_count = n;
+        arena_free(peg->arena); // release the Node tree
+        peg->arena = NULL;
+        peg->tree = NULL;
+    }
+    if (count) *count = peg->flat_count;
+    return peg->flat;
+}
+
+// -- saved trees -------------------------------------------
+
+// A saved tree is a header and the flat tree nodes, with no pointers, so
+// the file can be mapped and used in place. The header has the grammar
+// hash, and the input length with a hash of its first and last bytes,
+// for a check that the tree is loaded with the same grammar and input.
+// The nodes are in the machine byte order, with its peg_pos size.
+
+#define TREE_MAGIC 0x65657274474550LL // "PEGtree"
+#define TREE_SAMPLE 4096
+
+typedef struct {
+    long long magic;
+    int pos_size;   // sizeof(peg_pos)
+    int count;      // flat nodes
+    long long input_len;
+    unsigned long long input_hash;
+    unsigned long long grammar_hash;
+} TreeHead;
+
+unsigned long long fnv_hash(const char* s, size_t n, unsigned long long h) {
+    for (size_t i=0; i<n; i++) h = (h ^ (unsigned char)s[i])*0x100000001b3ULL;
+    return h;
+}
+
+void tree_head(Peg* tree, char* input, peg_pos len, TreeHead* head) {
+    memset(head, 0, sizeof(TreeHead));
+    head->magic = TREE_MAGIC;
+    head->pos_size = sizeof(peg_pos);
+    head->input_len = len;
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    peg_pos k = len < TREE_SAMPLE? len : TREE_SAMPLE;
+    head->input_hash = fnv_hash(input+len-k, k, fnv_hash(input, k, h));
+    Node* gram = tree->peg->tree;
+    head->grammar_hash = fnv_hash(tree->peg->src+gram->start, gram->end-gram->start, h);
+}
+
+bool save_tree(Peg* tree, char* path) {
+    if (tree->err || !tree->peg || !tree->peg->code) return false;
+    if (!tree->flat && !tree->tree) return false;
+    PegFlat* flat = tree->flat;
+    int count = tree->flat_count;
+    if (!flat) { // the Node tree is kept
+        count = flat_size(tree->tree);
+        flat = malloc(count*sizeof(PegFlat));
+        if (!flat) panic("malloc..");
+        flat_fill(flat, 0, tree->tree);
+    }
+    TreeHead head;
+    tree_head(tree, tree->src, flat[0].end, &head);
+    head.count = count;
+    FILE* f = fopen(path, "wb");
+    bool ok = f != NULL;
+    if (ok) ok = fwrite(&head, sizeof(TreeHead), 1, f) == 1;
+    if (ok) ok = fwrite(flat, sizeof(PegFlat), count, f) == (size_t)count;
+    if (f && fclose(f) != 0) ok = false;
+    if (flat != tree->flat) free(flat);
+    return ok;
+}
+
+Peg* load_tree(Peg* peg, char* path, char* input) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    char* buf = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(TreeHead)) {
+        buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (buf == MAP_FAILED) return NULL;
+    TreeHead* head = (TreeHead*)buf;
+    bool ok = head->magic == TREE_MAGIC && head->pos_size == sizeof(peg_pos) &&
+        head->count > 0 && st.st_size == (off_t)(sizeof(TreeHead)+head->count*sizeof(PegFlat));
+    if (ok) {
+        Peg* tree = newPeg(input, NULL, peg, NULL);
+        TreeHead check;
+        tree_head(tree, input, head->input_len, &check);
+        if (check.input_hash == head->input_hash && check.grammar_hash == head->grammar_hash) {
+            tree->buf = buf;
+            tree->map = st.st_size;
+            tree->flat = (PegFlat*)(buf+sizeof(TreeHead));
+            tree->flat_count = head->count;
+            tree->flat_map = true;
+            return tree;
+        }
+        free(tree);
+    }
+    munmap(buf, st.st_size);
+    return NULL;
+}
+
+// -- saved grammars -----------------------------------------
+
+// A compiled grammar image is a header and the code arrays, then the
+// grammar source and its tree as flat nodes. The arrays are used in
+// place from the file mapping, only the tree nodes are made again.
+// The header has a version, a hash of the grammar text span (to check it
+// is loaded for the same grammar), and a hash of the image.
+
+#define CODE_MAGIC 0x65646f63474550LL // "PEGcode"
+#define CODE_VERSION 2
+
+typedef struct {
+    long long magic;
+    int version;    // CODE_VERSION
+    int pos_size;   // sizeof(peg_pos)
+    unsigned long long src_hash;   // the grammar text span
+    unsigned long long image_hash; // the bytes after the header
+    int src_start;  // the grammar text span in the source
+    int src_len;    // the span end, the source is saved up to here
+    int len;        // ops
+    int exp_count;
+    int rule_count;
+    int node_count; // grammar tree flat nodes
+    int memo_limit;
+    int dispatch;
+} CodeHead;
+
+enum CODE_PART { C_SRC, C_OPS, C_FAIL, C_NOTE, C_EXP_RULE, C_EXPS,
+    C_ENTRY, C_MODE, C_MEMO, C_NODES, C_END };
+
+void code_layout(CodeHead* h, size_t* off) { // image part offsets
+    size_t size[C_END] = {
+        h->src_len+1, h->len*sizeof(int), h->len*sizeof(int), h->len*sizeof(int),
+        h->exp_count*sizeof(int), h->exp_count*sizeof(int), h->rule_count*sizeof(int),
+        h->rule_count, h->rule_count, h->node_count*sizeof(PegFlat) };
+    size_t at = sizeof(CodeHead);
+    for (int i=0; i<C_END; i++) {
+        off[i] = at;
+        at = (at+size[i]+7) & ~(size_t)7;
+    }
+    off[C_END] = at;
+}
+
+// The exps are saved as the pre-order index of their grammar nodes, found
+// by a binary search of the nodes sorted by address.
+
+typedef struct {
+    Node* node;
+    int index;  // pre-order
+} NodeIndex;
+
+int tree_nodes(Node* nd, NodeIndex* nodes, int i) {
+    nodes[i].node = nd;
+    nodes[i].index = i;
+    i += 1;
+    for (int j=0; j<nd->count; j++) i = tree_nodes(nd->nodes[j], nodes, i);
+    return i;
+}
+
+int node_cmp(const void* a, const void* b) { // by node address
+    size_t x = (size_t)((NodeIndex*)a)->node;
+    size_t y = (size_t)((NodeIndex*)b)->node;
+    return x < y? -1 : x > y;
+}
+
+NodeIndex* node_indexes(Node* tree, int n) { // n tree nodes, sorted by address
+    NodeIndex* nodes = malloc(n*sizeof(NodeIndex));
+    if (!nodes) panic("malloc..");
+    tree_nodes(tree, nodes, 0);
+    qsort(nodes, n, sizeof(NodeIndex), node_cmp);
+    return nodes;
+}
+
+int node_index(NodeIndex* nodes, int n, Node* nd) {
+    NodeIndex key = { nd, 0 };
+    NodeIndex* k = bsearch(&key, nodes, n, sizeof(NodeIndex), node_cmp);
+    return k? k->index : -1;
+}
+
+bool save_compiled(Peg* peg, char* path) {
+    Code* code = peg->code;
+    if (!code || peg->err) return false;
+    Node* tree = peg->tree;
+    CodeHead h;
+    memset(&h, 0, sizeof(CodeHead));
+    h.magic = CODE_MAGIC;
+    h.version = CODE_VERSION;
+    h.pos_size = sizeof(peg_pos);
+    h.src_start = tree->start;
+    h.src_len = tree->end;
+    h.src_hash = fnv_hash(peg->src+tree->start, tree->end-tree->start, 0xcbf29ce484222325ULL);
+    h.len = code->len;
+    h.exp_count = code->exp_count;
+    h.rule_count = code->rule_count;
+    h.node_count = flat_size(tree);
+    h.memo_limit = code->memo_limit;
+    h.dispatch = code->dispatch;
+    size_t off[C_END+1];
+    code_layout(&h, off);
+    char* image = calloc(1, off[C_END]);
+    if (!image) panic("malloc..");
+    memcpy(image+off[C_SRC], peg->src, h.src_len);
+    memcpy(image+off[C_OPS], code->ops, h.len*sizeof(int));
+    memcpy(image+off[C_FAIL], code->fail, h.len*sizeof(int));
+    memcpy(image+off[C_NOTE], code->note, h.len*sizeof(int));
+    memcpy(image+off[C_EXP_RULE], code->exp_rule, h.exp_count*sizeof(int));
+    NodeIndex* nodes = node_indexes(tree, h.node_count);
+    int* exps = (int*)(image+off[C_EXPS]);
+    for (int i=0; i<h.exp_count; i++) {
+        exps[i] = code->exps[i]? node_index(nodes, h.node_count, code->exps[i]) : -1;
+    }
+    memcpy(image+off[C_ENTRY], code->entry, h.rule_count*sizeof(int));
+    memcpy(image+off[C_MODE], code->mode, h.rule_count);
+    memcpy(image+off[C_MEMO], code->memo, h.rule_count);
+    flat_fill((PegFlat*)(image+off[C_NODES]), 0, tree);
+    h.image_hash = fnv_hash(image+sizeof(CodeHead), off[C_END]-sizeof(CodeHead), 0xcbf29ce484222325ULL);
+    memcpy(image, &h, sizeof(CodeHead));
+    FILE* f = fopen(path, "wb");
+    bool ok = f != NULL;
+    if (ok) ok = fwrite(image, off[C_END], 1, f) == 1;
+    if (f && fclose(f) != 0) ok = false;
+    free(nodes);
+    free(image);
+    return ok;
+}
+
+Node* unflat(Arena* a, PegFlat* flat, int i, Node** nodes) { // tree from flat
+    int n = 0;
+    for (int k=i+1; k<i+flat[i].size; k+=flat[k].size) n++;
+    Node* nd = newNode(a, flat[i].tag, flat[i].start, flat[i].end, n);
+    nodes[i] = nd;
+    n = 0;
+    for (int k=i+1; k<i+flat[i].size; k+=flat[k].size) {
+        nd->nodes[n++] = unflat(a, flat, k, nodes);
+    }
+    return nd;
+}
+
+Peg* load_compiled(char* path, char* grammar) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    char* image = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(CodeHead)) { // memo is writable
+        image = mmap(NULL, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (image == MAP_FAILED) return NULL;
+    CodeHead* h = (CodeHead*)image;
+    size_t off[C_END+1];
+    bool ok = h->magic == CODE_MAGIC && h->version == CODE_VERSION &&
+        h->pos_size == sizeof(peg_pos) && h->node_count > 0;
+    if (ok) {
+        code_layout(h, off);
+        ok = off[C_END] == (size_t)st.st_size;
+    }
+    if (ok) ok = h->src_start >= 0 && h->src_start <= h->src_len &&
+        memchr(grammar, 0, h->src_len) == NULL && h->src_hash ==
+        fnv_hash(grammar+h->src_start, h->src_len-h->src_start, 0xcbf29ce484222325ULL);
+    if (ok) ok = h->image_hash ==
+        fnv_hash(image+sizeof(CodeHead), off[C_END]-sizeof(CodeHead), 0xcbf29ce484222325ULL);
+    if (!ok) {
+        munmap(image, st.st_size);
+        return NULL;
+    }
+    Code* code = calloc(1, sizeof(Code));
+    if (!code) panic("malloc..");
+    code->ops = (int*)(image+off[C_OPS]);
+    code->len = h->len;
+    code->fail = (int*)(image+off[C_FAIL]);
+    code->note = (int*)(image+off[C_NOTE]);
+    code->exp_rule = (int*)(image+off[C_EXP_RULE]);
+    code->exp_count = h->exp_count;
+    code->entry = (int*)(image+off[C_ENTRY]);
+    code->mode = image+off[C_MODE];
+    code->rule_count = h->rule_count;
+    code->memo = image+off[C_MEMO];
+    code->memo_limit = h->memo_limit;
+    code->dispatch = h->dispatch;
+    code->image = image;
+    code->image_size = st.st_size;
+    Peg* peg = newPeg(image+off[C_SRC], NULL, NULL, NULL); // as BOOT made it
+    peg->arena = newArena();
+    Node** nodes = malloc(h->node_count*sizeof(Node*));
+    code->exps = malloc((h->exp_count+1)*sizeof(Node*));
+    if (!nodes || !code->exps) panic("malloc..");
+    peg->tree = unflat(peg->arena, (PegFlat*)(image+off[C_NODES]), 0, nodes);
+    int* exps = (int*)(image+off[C_EXPS]);
+    for (int i=0; i<h->exp_count; i++) code->exps[i] = exps[i] < 0? NULL : nodes[exps[i]];
+    free(nodes);
+    peg->code = code;
+    return peg;
+}
+
+// == C code generator ====================================
+
+// The parser machine code for a grammar can be generated as a C function,
+// each instruction is a case in a switch on the pc, with its operands as
+// constants, the literals as C strings, the char sets as C tests, and the
+// jumps as gotos, so a parse has no instruction decode. The C file includes
+// pPEG.c and compiles the grammar (for the rule names and fault reports),
+// it checks that the code is the same, then the parses run the C function.
+// The push parser and the trace and debug parses still use run().
+
+typedef struct {
+    FILE* out;
+    int* ops;
+    int len;
+    char* label; // pc => goto target
+    int* owner;  // LOOP or PEND pc => its REP or PRE pc
+    bool fails;  // goto fail
+    bool uses_ops;
+    bool uses_dispatch;
+} Gen;
+
+void gen_str(FILE* out, char* s, int len) { // a C string literal
+    fputc('"', out);
+    for (int i=0; i<len; i++) {
+        unsigned char c = s[i];
+        if (c == '\n' && i < len-1) fprintf(out, "\\n\"\n    \"");
+        else if (c == '\n') fprintf(out, "\\n");
+        else if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+        else if (c < 32 || c > 126 || (c == '?' && i > 0 && s[i-1] == '?')) {
+            fprintf(out, "\\%03o", c); // no ?? trigraphs
+        } else fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+void gen_char(FILE* out, int c) {
+    if (c > 32 && c < 127 && c != '\'' && c != '\\') fprintf(out, "'%c'", c);
+    else fprintf(out, "%d", c);
+}
+
+int gen_runs(int* set, int* lo, int* hi) { // byte ranges, or -1 if > 4
+    if (set[0] > 0) return -1; // ranges above 255
+    int n = 0;
+    for (int c=0; c<256; c++) {
+        if (!((set[1+(c>>5)] >> (c&31)) & 1)) continue;
+        if (n > 0 && hi[n-1] == c-1) hi[n-1] = c;
+        else if (n == 4) return -1;
+        else lo[n] = hi[n] = c, n++;
+    }
+    return n;
+}
+
+void gen_set(Gen* g, int* set, int at) { // a C test of c in the set at ops+at
+    int lo[4], hi[4];
+    int n = gen_runs(set, lo, hi);
+    if (n < 0) {
+        fprintf(g->out, "in_set(ops+%d, c)", at);
+        return;
+    }
+    if (n == 0) fprintf(g->out, "false");
+    for (int i=0; i<n; i++) {
+        if (i > 0) fprintf(g->out, " || ");
+        if (lo[i] == hi[i]) {
+            fprintf(g->out, "c == ");
+            gen_char(g->out, lo[i]);
+            continue;
+        }
+        fprintf(g->out, "(c >= ");
+        gen_char(g->out, lo[i]);
+        fprintf(g->out, " && c <= ");
+        gen_char(g->out, hi[i]);
+        fprintf(g->out, ")");
+    }
+}
+
+bool gen_ascii(int* set) { // no chars > 127 in the set
+    if (set[0] > 0) return false;
+    for (int i=4; i<8; i++) if (set[1+i]) return false;
+    return true;
+}
+
+void gen_fail(Gen* g, char* indent, int pc) {
+    fprintf(g->out, "%s{ pc = %d; goto fail; }\n", indent, pc);
+}
+
+void gen_marks(Gen* g) { // goto targets, and what the code uses
+    int* ops = g->ops;
+    for (int pc=0; pc<g->len; pc+=code_size(ops, pc)) {
+        switch (ops[pc]) {
+        case OP_CALL: g->label[ops[pc+1]] = g->label[pc+3] = 1; break;
+        case OP_DISPATCH:
+            g->label[pc+4+64+ops[pc+1]] = 1;
+            if (ops[pc+2] >= 0) {
+                g->label[ops[pc+2]] = 1;
+                g->uses_ops = g->uses_dispatch = true;
             }
-            return new_peg;
+            break;
+        case OP_COMMIT: g->label[ops[pc+1]] = 1; break;
+        case OP_REP:
+            if (ops[ops[pc+3]-1] != OP_LOOP) panic("gen: REP without a LOOP");
+            g->owner[ops[pc+3]-1] = pc;
+            g->label[pc+4] = 1;
+            break;
+        case OP_PRE:
+            if (ops[ops[pc+2]-1] != OP_PEND) panic("gen: PRE without a PEND");
+            g->owner[ops[pc+2]-1] = pc;
+            break;
+        case OP_SET: case OP_SPAN: {
+            int lo[4], hi[4];
+            int k = ops[pc+3];
+            bool scan = k >= 0 && ops[pc+1] <= 1 && ops[pc+2] == 0;
+            int* set = ops[pc] == OP_SET? ops+pc+1 : ops+pc+5+(k > 0? k : 0);
+            if ((ops[pc] == OP_SPAN && scan) || gen_runs(set, lo, hi) < 0) g->uses_ops = true;
+            break;
+        }
+        case OP_STRI: case OP_TRIE: case OP_AND_END: case OP_CMP_END: g->uses_ops = true; break;
         }
-        new_peg->err = newErr(PEG_FELL_SHORT, pen.pos > pen.fail? pen.pos : pen.fail);
-        return new_peg;
     }
+}
 
-    Err* err = newErr(PEG_FAILED, pen.pos > pen.fail? pen.pos : pen.fail);
-    err->fail_rule = pen.fail_rule;
-    err->expected = pen.expected;
-    Peg* bad_peg = newPeg(input, pen.results[0], peg, err);
+void gen_op(Gen* g, Code* code, char* grammar, int pc) {
+    FILE* out = g->out;
+    int* ops = g->ops;
+    int op = ops[pc];
+    int next = pc+code_size(ops, pc);
+    fprintf(out, "    case %d:", pc);
+    if (g->label[pc]) fprintf(out, " L%d:", pc);
+    fprintf(out, " { // %s", code_names[op]);
+    if (op == OP_CALL) {
+        Node* id = code->exps[code->note[pc]];
+        if (id) fprintf(out, " %.*s", (int)(id->end-id->start), grammar+id->start);
+    }
+    fprintf(out, "\n");
+    switch (op) {
+    case OP_CALL: {
+        int tag = ops[pc+2];
+        fprintf(out,
+            "        if (pen->memo && pen->code->memo[%d]) {\n"
+            "            Memo* m = memo_find(pen, %d, pen->pos);\n"
+            "            if (m) {\n"
+            "                if (!memo_hit(pen, m)) { pc = %d; goto fail; }\n"
+            "                goto L%d;\n"
+            "            }\n"
+            "        }\n"
+            "        if (pen->depth++ > MAX_DEPTH) panic(\"call recursion > MAX_DEPTH ....\");\n"
+            "        push(pen, F_CALL, %d, %d);\n"
+            "        goto L%d;\n", tag, tag, pc, next, pc, tag, ops[pc+1]);
+        g->fails = true;
+        break;
+    }
+    case OP_RET:
+        fprintf(out,
+            "        Frame* f = &pen->frames[--pen->top];\n"
+            "        int tag = f->count;\n"
+            "        pen->depth--;\n"
+            "        if (pen->release) events_ret(pen, f);\n"
+            "        else make_node(pen, tag, f->pos, f->stack);\n"
+            "        if (pen->memo && pen->code->memo[tag]) {\n"
+            "            memo_store(pen, tag, f->pos, f->stack);\n"
+            "        }\n"
+            "        if (f->site < 0) return true;\n"
+            "        pc = f->site+3;\n"
+            "        goto jump;\n");
+        break;
+    case OP_DISPATCH: {
+        int first = pc+4+64+ops[pc+1];
+        if (ops[pc+2] < 0) {
+            fprintf(out, "        goto L%d;\n", first);
+            break;
+        }
+        fprintf(out,
+            "        if (!dispatch) goto L%d;\n"
+            "        int mask = %d;\n"
+            "        if (pen->pos < pen->end) {\n"
+            "            unsigned char* map = (unsigned char*)(ops+%d);\n"
+            "            mask = ops[%d+map[(unsigned char)pen->input[pen->pos]]];\n"
+            "        }\n"
+            "        if (mask == 0) goto L%d;\n"
+            "        pc = %d;\n"
+            "        while (!(mask & 1)) {\n"
+            "            pc = ops[pc+1];\n"
+            "            mask >>= 1;\n"
+            "        }\n"
+            "        push(pen, F_ALT, pc, mask >> 1);\n"
+            "        pc += 2;\n"
+            "        goto jump;\n", first, ops[pc+3], pc+4, pc+68, ops[pc+2], first);
+        break;
+    }
+    case OP_CHOICE:
+        fprintf(out, "        push(pen, F_ALT, %d, -1);\n", pc);
+        break;
+    case OP_COMMIT:
+        fprintf(out, "        pen->top--;\n        goto L%d;\n", ops[pc+1]);
+        break;
+    case OP_FAIL:
+        gen_fail(g, "        ", pc);
+        g->fails = true;
+        break;
+    case OP_REP:
+        fprintf(out, "        push(pen, F_REP, %d, 0);\n", pc);
+        break;
+    case OP_LOOP: { // falls through to the REP exit
+        int rep = g->owner[pc];
+        int min = ops[rep+1], max = ops[rep+2];
+        fprintf(out,
+            "        Frame* f = &pen->frames[pen->top-1];\n"
+            "        if (pen->pos != f->pos) {\n"
+            "            f->pos = pen->pos;\n"
+            "            f->stack = pen->stack;\n"
+            "            f->mark = pen->arena->top;\n"
+            "            f->count += 1;\n"
+            "            if (pen->release) events_flush(pen);\n");
+        if (max == 0) fprintf(out, "            goto L%d;\n", rep+4);
+        else fprintf(out, "            if (f->count != %d) goto L%d;\n", max, rep+4);
+        fprintf(out,
+            "        } else {\n"
+            "            drop_results(pen, f);\n"
+            "        }\n"
+            "        pen->top--;\n");
+        if (min > 0) {
+            fprintf(out, "        if (f->count < %d) { pc = %d; goto fail; }\n", min, rep);
+            g->fails = true;
+        }
+        break;
+    }
+    case OP_PRE:
+        fprintf(out, "        push(pen, F_PRE, %d, 0);\n", pc);
+        break;
+    case OP_PEND: {
+        int pre = g->owner[pc];
+        fprintf(out,
+            "        Frame* f = &pen->frames[--pen->top];\n"
+            "        reset(pen, f);\n");
+        if (ops[pre+1] != '&') {
+            gen_fail(g, "        ", pre);
+            g->fails = true;
+        }
+        break;
+    }
+    case OP_STR: {
+        int len = ops[pc+1];
+        char* str = (char*)(ops+pc+2);
+        if (len == 0) break;
+        g->fails = true;
+        if (len == 1) {
+            fprintf(out, "        if (pen->pos >= pen->end || pen->input[pen->pos] != ");
+            if (str[0] > 32 && str[0] < 127 && str[0] != '\'' && str[0] != '\\') {
+                fprintf(out, "'%c'", str[0]);
+            } else fprintf(out, "(char)%d", (unsigned char)str[0]);
+            fprintf(out, ") { pc = %d; goto fail; }\n", pc);
+            fprintf(out, "        pen->pos += 1;\n");
+            break;
+        }
+        fprintf(out, "        if (pen->pos+%d > pen->end) { pc = %d; goto fail; }\n", len, pc);
+        fprintf(out, "        char* s = pen->input+pen->pos;\n        char* str = ");
+        gen_str(out, str, len);
+        fprintf(out, ";\n"
+            "        if (memcmp(s, str, %d) != 0) {\n"
+            "            int i = 0;\n"
+            "            while (s[i] == str[i]) i++;\n"
+            "            pen->pos += i;\n"
+            "            pc = %d;\n"
+            "            goto fail;\n"
+            "        }\n"
+            "        pen->pos += %d;\n", len, pc, len);
+        break;
+    }
+    case OP_STRI: {
+        int len = ops[pc+1];
+        g->fails = true;
+        fprintf(out,
+            "        if (pen->pos+%d > pen->end) { pc = %d; goto fail; }\n"
+            "        unsigned char* str = (unsigned char*)(ops+%d);\n"
+            "        unsigned char* s = (unsigned char*)pen->input+pen->pos;\n"
+            "        int i = 0;\n"
+            "        while (i < %d) {\n"
+            "            if (str[i] < 128) {\n"
+            "                if (upper_case[s[i]] != str[i]) break;\n"
+            "                i += 1;\n"
+            "                continue;\n"
+            "            }\n"
+            "            int n, m;\n"
+            "            int x = utf8_code((char*)str+i, %d-i, &n);\n"
+            "            int y = utf8_code((char*)s+i, %d-i, &m);\n"
+            "            if (n != m || case_fold(y) != x) break;\n"
+            "            i += n;\n"
+            "        }\n"
+            "        pen->pos += i;\n"
+            "        if (i < %d) { pc = %d; goto fail; }\n", len, pc, pc+2, len, len, len, len, pc);
+        break;
+    }
+    case OP_TRIE:
+        g->fails = true;
+        fprintf(out,
+            "        int* t = ops+%d;\n"
+            "        char* bytes = (char*)(t+%d);\n"
+            "        int* node = t+%d;\n"
+            "        int best = -1;\n"
+            "        int len = 0;\n"
+            "        for (peg_pos i=pen->pos; ; i++) {\n"
+            "            for (int j=1; j<=node[0]; j++) {\n"
+            "                int lit = node[j];\n"
+            "                if (best >= 0 && lit > best) break;\n"
+            "                int* l = t+3+3*lit;\n"
+            "                if (l[2] || memcmp(bytes+l[0], pen->input+pen->pos, l[1]) == 0) {\n"
+            "                    best = lit;\n"
+            "                    len = l[1];\n"
+            "                    break;\n"
+            "                }\n"
+            "            }\n"
+            "            if (best == 0 || i >= pen->end) break;\n"
+            "            int b = upper_case[(unsigned char)pen->input[i]];\n"
+            "            int* edges = node+1+node[0];\n"
+            "            int k = 0;\n"
+            "            while (k < edges[0] && edges[1+2*k] != b) k++;\n"
+            "            if (k == edges[0]) break;\n"
+            "            node = t+edges[2+2*k];\n"
+            "        }\n"
+            "        if (best < 0) { pc = %d; goto fail; }\n"
+            "        pen->pos += len;\n", pc+2, ops[pc+3], ops[pc+4], pc);
+        break;
+    case OP_SET: {
+        int* set = ops+pc+1;
+        g->fails = true;
+        int lo[4], hi[4];
+        if (gen_runs(set, lo, hi) == 0) { // [] no chars
+            gen_fail(g, "        ", pc);
+            break;
+        }
+        fprintf(out,
+            "        if (pen->pos >= pen->end) { pc = %d; goto fail; }\n"
+            "        int c = (unsigned char)pen->input[pen->pos];\n", pc);
+        if (gen_ascii(set)) {
+            fprintf(out, "        if (!(");
+            gen_set(g, set, pc+1);
+            fprintf(out, ")) { pc = %d; goto fail; }\n", pc);
+            fprintf(out, "        pen->pos += 1;\n");
+            break;
+        }
+        fprintf(out,
+            "        int n = 1;\n"
+            "        if (c > 127) c = utf8_code(pen->input+pen->pos, pen->end-pen->pos, &n);\n"
+            "        if (!(");
+        gen_set(g, set, pc+1);
+        fprintf(out, ")) { pc = %d; goto fail; }\n", pc);
+        fprintf(out, "        pen->pos += n;\n");
+        break;
+    }
+    case OP_SPAN: {
+        int min = ops[pc+1], max = ops[pc+2], k = ops[pc+3];
+        int at = pc+5+(k > 0? k : 0); // set
+        if (k >= 0 && min <= 1 && max == 0) {
+            if (min == 1) fprintf(out, "        peg_pos start = pen->pos;\n");
+            fprintf(out, "        pen->pos = span_scan(pen->input, pen->pos, pen->end, ops+%d);\n", pc+3);
+            if (min == 1) fprintf(out, "        if (pen->pos == start) { pc = %d; goto fail; }\n", pc);
+            if (min == 1) g->fails = true;
+            break;
+        }
+        fprintf(out,
+            "        int count = 0;\n"
+            "        while (%s%d) {\n"
+            "            if (pen->pos >= pen->end) break;\n"
+            "            int c = (unsigned char)pen->input[pen->pos];\n"
+            "            int n = 1;\n"
+            "            if (c > 127) c = utf8_code(pen->input+pen->pos, pen->end-pen->pos, &n);\n"
+            "            if (!(", max == 0? "" : "count < ", max == 0? 1 : max);
+        gen_set(g, ops+at, at);
+        fprintf(out, ")) break;\n"
+            "            pen->pos += n;\n"
+            "            count += 1;\n"
+            "        }\n");
+        if (min > 0) {
+            fprintf(out, "        if (count < %d) { pc = %d; goto fail; }\n", min, pc);
+            g->fails = true;
+        }
+        break;
+    }
+    case OP_BUILTIN:
+        fprintf(out, "        if (!builtin(pen, %d)) { pc = %d; goto fail; }\n", ops[pc+1], pc);
+        g->fails = true;
+        break;
+    case OP_PRIOR:
+        fprintf(out, "        if (!ext_id(pen, %d)) { pc = %d; goto fail; }\n", ops[pc+1], pc);
+        g->fails = true;
+        break;
+    case OP_AND: case OP_CMP:
+        fprintf(out, "        push(pen, F_MARK, %d, 0);\n", pc);
+        break;
+    case OP_AND_END:
+        fprintf(out,
+            "        Frame* f = &pen->frames[--pen->top];\n"
+            "        ext_and_end(pen, f, ops[f->site+1]);\n");
+        break;
+    case OP_CMP_END:
+        fprintf(out,
+            "        Frame* f = &pen->frames[--pen->top];\n"
+            "        peg_pos size = pen->pos - f->pos;\n"
+            "        drop_results(pen, f);\n"
+            "        peg_pos len = prior_len(pen, ops[f->site+2]);\n"
+            "        if (!ext_compare(ops[f->site+1], size, len)) { pc = %d; goto fail; }\n", pc);
+        g->fails = true;
+        break;
+    case OP_BAD:
+        fprintf(out,
+            "        printf(\"%s\");\n"
+            "        print_text(pen->grammar, pen->code->exps[pen->code->note[%d]]);\n"
+            "        printf(\"\\n\");\n", ops[pc+1] == BAD_CALL?
+                "*** Not implemented: " : "**** Undefined extn: ", pc);
+        gen_fail(g, "        ", pc);
+        g->fails = true;
+        break;
+    default: panic("gen: undefined op");
+    }
+    fprintf(out, "    }\n");
+    bool jumps = op == OP_CALL || op == OP_RET || op == OP_DISPATCH || op == OP_COMMIT ||
+        op == OP_FAIL || op == OP_BAD || (op == OP_PEND && ops[g->owner[pc]+1] != '&');
+    if (!jumps && next < g->len) fprintf(out, "    // fallthrough\n");
+}
 
-    return bad_peg;
+bool gen_name(char* name) { // a C identifier
+    if (!name || !name[0] || (name[0] >= '0' && name[0] <= '9')) return false;
+    for (char* s=name; *s; s++) {
+        char c = *s;
+        if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9'))) return false;
+    }
+    return true;
+}
+
+bool gen_c(Peg* peg, char* name, FILE* out) {
+    Code* code = peg->code;
+    if (!code || peg->err || !gen_name(name)) return false;
+    Gen g = { out, code->ops, code->len, calloc(code->len+1, 1),
+        calloc(code->len+1, sizeof(int)), false, false, false };
+    if (!g.label || !g.owner) panic("malloc..");
+    gen_marks(&g);
+    char* grammar = peg->src;
+    Node* tree = peg->tree;
+    unsigned long long hash = fnv_hash((char*)code->ops, code->len*sizeof(int), 0xcbf29ce484222325ULL);
+    fprintf(out, "// generated by pPEG peg_gen_c, a parser for the grammar %s_grammar,\n", name);
+    fprintf(out, "// compile this file and not pPEG.c, it includes pPEG.c\n\n");
+    fprintf(out, "#include \"pPEG.c\"\n\n");
+    fprintf(out, "char* %s_grammar =\n    ", name);
+    gen_str(out, grammar+tree->start, tree->end-tree->start);
+    fprintf(out, ";\n\n");
+    // the switch and its body: written to a temp file as the fails flag is needed first
+    FILE* body = tmpfile();
+    if (!body) {
+        free(g.label);
+        free(g.owner);
+        return false;
+    }
+    g.out = body;
+    for (int pc=0; pc<code->len; pc+=code_size(code->ops, pc)) gen_op(&g, code, grammar, pc);
+    g.out = out;
+    fprintf(out, "static bool %s_run(Env* pen, int rule) {\n", name);
+    if (g.uses_ops) fprintf(out, "    int* ops = pen->code->ops;\n");
+    if (g.uses_dispatch) fprintf(out, "    bool dispatch = pen->dispatch;\n");
+    fprintf(out,
+        "    int base = pen->top;\n"
+        "    if (pen->depth++ > MAX_DEPTH) panic(\"call recursion > MAX_DEPTH ....\");\n"
+        "    push(pen, F_CALL, -1, rule);\n"
+        "    int pc = pen->code->entry[rule];\n"
+        "  jump:\n"
+        "    switch (pc) {\n");
+    rewind(body);
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), body)) > 0) fwrite(buf, 1, n, out);
+    fclose(body);
+    fprintf(out,
+        "    }\n"
+        "    panic(\"woops: generated parser pc\");\n");
+    if (g.fails) fprintf(out,
+        "  fail:\n"
+        "    pc = backtrack(pen, pc, base);\n"
+        "    if (pc < 0) return false;\n"
+        "    goto jump;\n");
+    else fprintf(out, "    return false;\n");
+    fprintf(out,
+        "}\n\n"
+        "// returns the compiled grammar, its parses run %s_run\n"
+        "Peg* %s_peg(void) {\n"
+        "    Peg* peg = peg_compile(%s_grammar);\n"
+        "    if (peg->err) return peg;\n"
+        "    Code* code = peg->code;\n"
+        "    if (code->len != %d || fnv_hash((char*)code->ops, code->len*sizeof(int),\n"
+        "        0xcbf29ce484222325ULL) != 0x%llxULL) {\n"
+        "        panic(\"%s: generated by another pPEG.c version, generate it again\");\n"
+        "    }\n"
+        "    code->run = %s_run;\n"
+        "    return peg;\n"
+        "}\n", name, name, name, code->len, hash, name, name);
+    free(g.label);
+    free(g.owner);
+    return !ferror(out);
+}
+
+bool gen_file(Peg* peg, char* name, char* path) {
+    if (!peg->code || peg->err || !gen_name(name)) return false;
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    bool ok = gen_c(peg, name, f);
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+// == File parser =========================================
+
+// The file is mapped read-only and parsed in place, the mapping is owned
+// by the tree. The map reserves a page of zeros past the end of the file,
+// so the input still has a 0 end for the fault reports.
+
+char* map_file(char* path, peg_pos* len, size_t* map) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    peg_pos max = (peg_pos)((1ULL << (sizeof(peg_pos)*8-1)) - 1);
+    if (fstat(fd, &st) < 0 || st.st_size >= max) {
+        close(fd);
+        return NULL;
+    }
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t size = (st.st_size/page + 1)*page;
+    char* buf = mmap(NULL, size, PROT_READ, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (buf != MAP_FAILED && st.st_size > 0) { // the file over the zeros..
+        if (mmap(buf, st.st_size, PROT_READ, MAP_PRIVATE|MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(buf, size);
+            buf = MAP_FAILED;
+        }
+    }
+    close(fd);
+    if (buf == MAP_FAILED) return NULL;
+    madvise(buf, st.st_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(buf, st.st_size, MADV_HUGEPAGE);
+#endif
+    *len = st.st_size;
+    *map = size;
+    return buf;
+}
+
+Peg* file_parser(Peg* peg, char* path) {
+    peg_pos len;
+    size_t map;
+    char* buf = map_file(path, &len, &map);
+    if (!buf) return NULL;
+    Peg* tree = peg_parser(peg, buf, 0, len, 0);
+    tree->buf = buf;
+    tree->map = map;
+    return tree;
+}
+
+Peg* grammar_compile(Peg* peg) { // compile grammar ptree into parser code
+    if (peg->err) return peg;
+    Node* undefined = NULL;
+    Code* code = compile(peg->src, peg->tree, &undefined);
+    if (undefined) {
+        code_free(code);
+        peg->err = newErr(PEG_UNDEFINED, undefined->start);
+        peg->err->expected = undefined;
+        return peg;
+    }
+    peg->code = code;
+    return peg;
 }
 
 // ==  API  ============================================
 
 // returns a ptr to a parser for the grammar
 extern Peg* peg_compile(char* grammar) {
-    return peg_parser(BOOT, grammar, 0, strlen(grammar), 0);
+    return grammar_compile(peg_parser(NULL, grammar, 0, strlen(grammar), 0));
 }
 
 // comiple text from start to end, returns a ptr to a parser
-extern Peg* peg_compile_text(char* grammar, int start, int end) {
-    return peg_parser(BOOT, grammar, start, end, 0);
+extern Peg* peg_compile_text(char* grammar, peg_pos start, peg_pos end) {
+    return grammar_compile(peg_parser(NULL, grammar, start, end, 0));
 }
 
 // parse input string using peg parser..
@@ -1486,10 +4605,122 @@ extern Peg* peg_parse(Peg* peg, char* input) {
 }
 
 // parse a slice of input from start to end..
-extern Peg* peg_parse_text(Peg* peg, char* input, int start, int end) {
+extern Peg* peg_parse_text(Peg* peg, char* input, peg_pos start, peg_pos end) {
     return peg_parser(peg, input, start, end, 0);
 }
 
+// event mode: parse input from start to end, the tree nodes are sent to
+// the events as soon as they are final, returns no tree, or an error.
+extern Peg* peg_parse_events(Peg* peg, char* input, peg_pos start, peg_pos end, PegEvents* events) {
+    return events_parser(peg, input, start, end, events);
+}
+
+// start a push parse, the input is given to peg_feed in chunks..
+extern PegFeed* peg_push(Peg* peg) {
+    return feed_start(peg);
+}
+
+// parse the next chunk of input, returns false if the parse has
+// ended (the result is known) before the end of the input.
+extern bool peg_feed(PegFeed* ctx, char* input, size_t len) {
+    return feed(ctx, input, len);
+}
+
+// end of the input, returns the parse tree (or error), ctx is freed.
+extern Peg* peg_finish(PegFeed* ctx) {
+    return feed_finish(ctx);
+}
+
+// parse a file, mapped in place (not copied) for as long as the tree,
+// returns NULL if the file can not be read.
+extern Peg* peg_parse_file(Peg* peg, char* path) {
+    return file_parser(peg, path);
+}
+
+
+// the parse tree as one pre-order array of count nodes, the Node tree
+// is released (peg_tree is then NULL), the array is owned by the peg.
+extern PegFlat* peg_flat(Peg* peg, int* count) {
+    return flat_tree(peg, count);
+}
+
+// save a parse tree to a file, returns false if it can not be written.
+extern bool peg_save_tree(Peg* tree, char* path) {
+    return save_tree(tree, path);
+}
+
+// load a tree saved from a parse of input with the peg grammar, as a
+// flat tree mapped from the file, returns NULL if it does not match.
+extern Peg* peg_load_tree(Peg* peg, char* path, char* input) {
+    return load_tree(peg, path, input);
+}
+
+// save a compiled grammar image to a file, returns false if it can not be written.
+extern bool peg_save_compiled(Peg* peg, char* path) {
+    return save_compiled(peg, path);
+}
+
+// load a compiled grammar image, mapped from the file, returns NULL if it
+// is not an image of this grammar source (or another version).
+extern Peg* peg_load_compiled(char* path, char* grammar) {
+    return load_compiled(path, grammar);
+}
+
+// generate a C file with a parser for the grammar, it has a function
+// `Peg* name_peg(void)` that compiles the grammar for the generated parser.
+extern bool peg_gen_c(Peg* peg, char* name, char* path) {
+    return gen_file(peg, name, path);
+}
+
+// profile mode: the first call starts the rule counters for the parses
+// with the grammar, each call returns them, an array of count rules.
+// make the first call before any parse that may run at the same time.
+extern PegProfile* peg_profile(Peg* peg, int* count) {
+    return profile_start(peg, count);
+}
+
+// print the rule profile, sorted by the input bytes backtracked.
+extern void peg_profile_print(Peg* peg) {
+    profile_print(peg);
+}
+
+// packrat mode: memoize the results of rule `name`, or all rules if NULL,
+// returns false if there is no such rule that can be memoized.
+extern bool peg_memo(Peg* peg, char* name) {
+    Code* code = peg->code;
+    if (!code) return false;
+    int n = code->rule_count;
+    char prior[n];
+    rule_priors(code, prior);
+    bool ok = false;
+    for (int i=0; i<n; i++) {
+        if (prior[i]) continue;
+        Node* id = peg->tree->nodes[i]->nodes[0];
+        int len = id->end - id->start;
+        if (name && (strncmp(peg->src+id->start, name, len) || name[len])) continue;
+        code->memo[i] = 1;
+        ok = true;
+    }
+    return ok;
+}
+
+// limit the packrat memo table memory for each parse, in bytes.
+extern void peg_memo_limit(Peg* peg, int bytes) {
+    if (peg->code) peg->code->memo_limit = bytes;
+}
+
+// release a parse tree, or a grammar and its parser code,
+// a grammar must not be released before the trees parsed with it.
+extern void peg_free(Peg* peg) {
+    if (!peg || peg == BOOT) return; // BOOT is kept
+    if (peg->arena) arena_free(peg->arena);
+    if (peg->code) code_free(peg->code);
+    if (peg->map) munmap(peg->buf, peg->map);
+    else free(peg->buf);
+    if (!peg->flat_map) free(peg->flat);
+    free(peg->err);
+    free(peg);
+}
 
 // display the parse tree or error report
 extern void peg_print(Peg* peg) {
@@ -1512,7 +4743,7 @@ extern Node* peg_tree(Peg* peg) {
 // copies node text span into `text` string arg, with a 0 end,
 // limit of max length, truncated if necessary.
 extern void peg_text(Peg* peg, Node* node, char* text, int max) {
-    int len = node->end - node->start;
+    peg_pos len = node->end - node->start;
     int limit = len < max? len : max;
     char* ptr = peg->src + node->start;
     memcpy(text, ptr, limit);
@@ -1530,6 +4761,27 @@ extern void peg_name(Peg* peg, Node* node, char* name, int max) {
     *(name+limit) = '\0';
 }
 
+// the node text span, a view into the input, with no 0 end.
+extern PegSpan peg_span(Peg* peg, Node* node) {
+    PegSpan span = { peg->src + node->start, node->end - node->start };
+    return span;
+}
+
+// the node rule name, a view into the grammar source, with no 0 end.
+extern PegSpan peg_name_span(Peg* peg, Node* node) {
+    Node* id = peg->peg->tree->nodes[node->tag]->nodes[0];
+    PegSpan span = { peg->peg->src + id->start, id->end - id->start };
+    return span;
+}
+
+// input offsets of the node text span, start and last+1
+extern peg_pos peg_start(Node* node) {
+    return node->start;
+}
+extern peg_pos peg_end(Node* node) {
+    return node->end;
+}
+
 // returns index of rule name
 extern int peg_tag(Node* node) {
     return node->tag;
@@ -1549,14 +4801,23 @@ extern Node* peg_nodes(Node* node, int i) {
 extern Peg* peg_trace(Peg* peg, char* input) {
     return peg_parser(peg, input, 0, strlen(input), 2);
 }
-extern Peg* peg_trace_text(Peg* peg, char* input, int start, int end) {
+extern Peg* peg_trace_text(Peg* peg, char* input, peg_pos start, peg_pos end) {
     return peg_parser(peg, input, start, end, 2);
 }
 
+// print out the input spans that are scanned again the most, and the rule
+// stacks that rescan them, in buckets of input bytes (0 for 64 bytes).
+extern Peg* peg_heatmap(Peg* peg, char* input, int bucket) {
+    return heat_parser(peg, input, 0, strlen(input), bucket);
+}
+extern Peg* peg_heatmap_text(Peg* peg, char* input, peg_pos start, peg_pos end, int bucket) {
+    return heat_parser(peg, input, start, end, bucket);
+}
+
 // print out a low level trace of the parser instructions..
 extern Peg* peg_debug(Peg* peg, char* input) {
     return peg_parser(peg, input, 0, strlen(input), 1);
 }
-extern Peg* peg_debug_text(Peg* peg, char* input, int start, int end) {
+extern Peg* peg_debug_text(Peg* peg, char* input, peg_pos start, peg_pos end) {
     return peg_parser(peg, input, start, end, 1);
 }
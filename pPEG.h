@@ -1,17 +1,126 @@
 #include <stdbool.h>
+#include <stddef.h>
+
+// input positions, an int, or for inputs over 2GB build pPEG.c and
+// its users with -DPEG_POS64 (the tree nodes are then 8 bytes larger).
+#ifdef PEG_POS64
+typedef long long peg_pos;
+#else
+typedef int peg_pos;
+#endif
 
 typedef struct Peg Peg;
 typedef struct Node Node;
+typedef struct PegFeed PegFeed;
+
+// flat parse tree node, the nodes are in pre-order, the children of
+// node i start at i+1, and its next sibling is at i+size.
+typedef struct {
+    peg_pos start; // start string span
+    peg_pos end;   // last+1 string span
+    int tag;       // rule name index
+    int size;      // nodes in this sub-tree, including this node
+} PegFlat;
+
+// a view of the input or grammar text, it is not 0 terminated.
+typedef struct {
+    const char* ptr;
+    size_t len;
+} PegSpan;
+
+// event mode callbacks, any may be NULL, the ctx is passed to each.
+// a rule node with children has an enter and exit, other nodes a leaf.
+typedef struct {
+    void (*enter)(void* ctx, int tag, peg_pos start);
+    void (*exit)(void* ctx, int tag, peg_pos start, peg_pos end);
+    void (*leaf)(void* ctx, int tag, peg_pos start, peg_pos end);
+    void* ctx;
+} PegEvents;
+
+// rule profile counters, for each rule index (peg_profile).
+typedef struct {
+    long long calls;     // rule runs (memo hits are not counted)
+    long long matches;   // calls that matched
+    long long fails;     // calls that failed
+    long long bytes;     // input matched by the calls that matched
+    long long backtrack; // input matched by the calls that failed, before they failed
+    long long nodes;     // tree nodes made by the rule
+    long long dropped;   // of the rule nodes, made and dropped by a backtrack
+} PegProfile;
 
 // returns a ptr to a parser for the grammar
 Peg* peg_compile(char* grammar);
 
-Peg* peg_compile_text(char* grammar, int start, int end);
+Peg* peg_compile_text(char* grammar, peg_pos start, peg_pos end);
 
 // parse input string using peg parser, return peg ptree..
+// a peg parser may be shared by threads, it is not changed by a parse.
 Peg* peg_parse(Peg* peg, char* input);
 
-Peg* peg_parse_text(Peg* peg, char* input, int start, int end);
+Peg* peg_parse_text(Peg* peg, char* input, peg_pos start, peg_pos end);
+
+// event mode: parse input from start to end, the tree nodes are sent to
+// the events as soon as they are final, returns no tree, or an error.
+// The events for a partial tree may be sent before an error is found,
+// so discard all the events received when an error is returned.
+Peg* peg_parse_events(Peg* peg, char* input, peg_pos start, peg_pos end, PegEvents* events);
+
+// push parser: start a parse, feed it the input in chunks, then finish,
+// peg_feed returns false if the parse has ended before the input.
+PegFeed* peg_push(Peg* peg);
+bool peg_feed(PegFeed* ctx, char* input, size_t len);
+Peg* peg_finish(PegFeed* ctx); // returns the ptree, and frees ctx
+
+// parse a file, mapped in place (not copied) for as long as the tree,
+// returns NULL if the file can not be read.
+Peg* peg_parse_file(Peg* peg, char* path);
+
+// the parse tree as one pre-order array of count nodes, the Node tree
+// is released (peg_tree is then NULL), the array is owned by the peg.
+PegFlat* peg_flat(Peg* peg, int* count);
+
+// save a parse tree to a file, returns false if it can not be written.
+bool peg_save_tree(Peg* tree, char* path);
+
+// load a tree saved from a parse of input with the peg grammar, as a
+// flat tree mapped from the file, returns NULL if it does not match.
+Peg* peg_load_tree(Peg* peg, char* path, char* input);
+
+// save a compiled grammar image to a file, returns false if it can not be written.
+bool peg_save_compiled(Peg* peg, char* path);
+
+// load a compiled grammar image, mapped from the file, returns NULL if it
+// is not an image of this grammar source (or another version), the same
+// text span of it for a grammar compiled with peg_compile_text.
+Peg* peg_load_compiled(char* path, char* grammar);
+
+// generate a C file with a parser for the grammar, it has a function
+// `Peg* name_peg(void)` that compiles the grammar for the generated parser.
+// The file is not standalone, it includes pPEG.c, and it must be built
+// with the pPEG.c version that generated it (name_peg panics if not).
+// It removes the instruction decode cost of a parse, not the compile cost:
+// name_peg compiles the grammar each time it is called.
+bool peg_gen_c(Peg* peg, char* name, char* path);
+
+// profile mode: the first call starts the rule counters for the parses
+// with the grammar, each call returns them, an array of count rules.
+// make the first call before any parse that may run at the same time.
+PegProfile* peg_profile(Peg* peg, int* count);
+
+// print the rule profile, sorted by the input bytes backtracked.
+void peg_profile_print(Peg* peg);
+
+// packrat mode: memoize the results of rule `name`, or all rules if NULL,
+// returns false if there is no such rule that can be memoized.
+bool peg_memo(Peg* peg, char* name);
+
+// limit the packrat memo table memory for each parse, in bytes.
+// set the memo before any parse that may run at the same time.
+void peg_memo_limit(Peg* peg, int bytes);
+
+// release a parse tree, or a grammar and its parser code,
+// a grammar must not be released before the trees parsed with it.
+void peg_free(Peg* peg);
 
 // display the parse tree or error report
 void peg_print(Peg* peg);
@@ -30,6 +139,10 @@ void peg_name(Peg*, Node*, char* name, int max);
 // limit of max length, truncated if necessary.
 void peg_text(Peg*, Node*, char* text, int max);
 
+// the node text, or the node rule name, without a copy.
+PegSpan peg_span(Peg*, Node*);
+PegSpan peg_name_span(Peg*, Node*);
+
 // Node* access ........
 
 // returns index of rule name
@@ -41,11 +154,20 @@ int peg_count(Node*);
 // returns ptr to the ith child node
 Node* peg_nodes(Node*, int);
 
+// returns the input offsets of the node text, start and last+1
+peg_pos peg_start(Node*);
+peg_pos peg_end(Node*);
+
 
 // print out a trace of the parse rule matches...
 Peg* peg_trace(Peg* peg, char* input);
-Peg* peg_trace_text(Peg* peg, char* input, int start, int end);
+Peg* peg_trace_text(Peg* peg, char* input, peg_pos start, peg_pos end);
+
+// print out the input spans that are scanned again the most, and the rule
+// stacks that rescan them, in buckets of input bytes (0 for 64 bytes).
+Peg* peg_heatmap(Peg* peg, char* input, int bucket);
+Peg* peg_heatmap_text(Peg* peg, char* input, peg_pos start, peg_pos end, int bucket);
 
 // print out a low level trace of the parser instructions..
 Peg* peg_debug(Peg* peg, char* input);
-Peg* peg_debug_text(Peg* peg, char* input, int start, int end);
+Peg* peg_debug_text(Peg* peg, char* input, peg_pos start, peg_pos end);
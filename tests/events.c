@@ -0,0 +1,108 @@
+#include <string.h>
+#include "test-kit.c"
+
+// the events are written out as text, to compare with the tree..
+
+typedef struct {
+    char* out;
+    int len;
+    int max;
+} Text;
+
+void put(Text* t, char* fmt, int tag, long long start, long long end) {
+    if (t->len+100 > t->max) {
+        t->max = t->max*2+1000;
+        t->out = realloc(t->out, t->max);
+    }
+    t->len += sprintf(t->out+t->len, fmt, tag, start, end);
+}
+
+void enter_event(void* ctx, int tag, peg_pos start) {
+    put(ctx, "(%d %lld ", tag, start, 0);
+}
+void exit_event(void* ctx, int tag, peg_pos start, peg_pos end) {
+    put(ctx, "%d %lld %lld) ", tag, start, end);
+}
+void leaf_event(void* ctx, int tag, peg_pos start, peg_pos end) {
+    put(ctx, "%d %lld %lld ", tag, start, end);
+}
+
+void tree_text(Text* t, Node* nd) {
+    if (peg_count(nd) == 0) {
+        leaf_event(t, peg_tag(nd), peg_start(nd), peg_end(nd));
+        return;
+    }
+    enter_event(t, peg_tag(nd), peg_start(nd));
+    for (int i=0; i<peg_count(nd); i++) tree_text(t, peg_nodes(nd, i));
+    exit_event(t, peg_tag(nd), peg_start(nd), peg_end(nd));
+}
+
+void test_events(char* grammar, char* input) { // the same as the tree
+    Peg* peg = peg_compile(grammar);
+    Peg* p = peg_parse(peg, input);
+    Text a = { NULL, 0, 0 };
+    Text b = { NULL, 0, 0 };
+    put(&a, "", 0, 0, 0);
+    put(&b, "", 0, 0, 0);
+    if (!peg_err(p)) tree_text(&a, peg_tree(p));
+    PegEvents events = { enter_event, exit_event, leaf_event, &b };
+    Peg* q = peg_parse_events(peg, input, 0, strlen(input), &events);
+    if (peg_err(p) != peg_err(q) || (!peg_err(p) && strcmp(a.out, b.out) != 0)) {
+        printf("**** events differ for: %s\n%s\n%s\n", input, a.out, b.out);
+    }
+    if (peg_err(q)) peg_print(q);
+    free(a.out);
+    free(b.out);
+    peg_free(q);
+    peg_free(p);
+    peg_free(peg);
+}
+
+int main(void) {
+    printf("Test event mode ...\n");
+
+    char* json =
+    "json   = _ value _                          \n"
+    "value  = Str / Arr / Obj / num / lit        \n"
+    "Obj    = '{'_ (memb (_','_ memb)*)? _'}'    \n"
+    "memb   = Str _':'_ value                    \n"
+    "Arr    = '['_ (value (_','_ value)*)? _']'  \n"
+    "Str    = _DQ chars* _DQ                     \n"
+    "chars  = ~(_0-1F/_BS/_DQ)+ / _BS [\"/bnrt]  \n"
+    "num    = '-'? [0-9]+ ('.' [0-9]+)?          \n"
+    "lit    = 'true' / 'false' / 'null'          \n";
+
+    test_events(json, "{ \"a\": [1, 2.5, \"x\\\"y\", true, null], \"b\": {} }");
+    test_events(json, "[[[1]], [], [2, [3, [4]]], {\"k\": [5]}]");
+    test_events(json, "42");
+    test_events(json, "[1, 2, tru]");
+
+    // lines, each is final at the end of its repeat..
+    char* lines =
+    "log   = (line '\\n')* end?     \n"
+    "line  = word (' ' word)*       \n"
+    "word  = [a-z]+                 \n"
+    "end   = [.]                    \n";
+    test_events(lines, "one two\nthree\nfour five six\n.");
+    test_events(lines, "one two\nthree\n x\n");
+
+    // inlined and skip rules, elided nodes..
+    char* opt =
+    "list  = _sp item (_sp ',' _sp item)* _sp   \n"
+    "item  = num / (_key / (word / '-'))        \n"
+    "num   = _dig+                              \n"
+    "word  = [a-z]+                             \n"
+    "_key  = 'nil' / 'any'                      \n"
+    "_dig  = [0-9]                              \n"
+    "_sp   = [ \\t]*                             \n";
+    test_events(opt, " 42, nil ,x, - ");
+
+    // the prior match extension, the results are kept to the end..
+    char* prior =
+    "s     = (q str q)*           \n"
+    "q     = [\"']                \n"
+    "str   = ~<id q>*             \n";
+    test_events(prior, "'a\"b'\"c'd\"");
+
+    printf("OK, event tests done...\n");
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Generated C parsers (peg_gen_c) give the same trees and errors as the
+// parser machine. Each grammar is generated, then compiled with this file
+// as its driver (-DGEN), and run from the tests directory:
+//
+//   > cc gen.c ../pPEG.c -o gen -lpthread && ./gen
+//
+// CC names the C compiler for the generated parsers, the default is cc.
+
+typedef struct {
+    char* name;
+    char* grammar;
+    char* inputs[4]; // each one also with a byte dropped, or changed
+} GenTest;
+
+GenTest tests[] = {
+    { "json",
+    "json   = _ value _                                  \n"
+    "value  =  Str / Arr / Obj / num / lit               \n"
+    "Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+    "memb   = Str _':'_ value                            \n"
+    "Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+    "Str    = _DQ chars* _DQ                             \n"
+    "chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+    "esc    = [/bfnrt] / _DQ / _BS / 'u' [0-9a-fA-F]*4   \n"
+    "num    = _int _frac? _exp?                          \n"
+    "_int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+    "_frac  = '.' [0-9]+                                 \n"
+    "_exp   = [eE] [+-]? [0-9]+                          \n"
+    "lit    = 'true' / 'false' / 'null'                  \n",
+    { "{\"a\": [1, -2.5e3, \"x\\\"y\\u00e9\", true, null], \"«é»\": {}}",
+      "[0, {\"k\": false}, [], \"\"]", NULL } },
+    { "uri",
+    "URI     = (scheme ':')? ('//' auth)? path  \n"
+    "          ('?' query)? ('#' frag)?         \n"
+    "scheme  = ~[:/?#]+                         \n"
+    "auth    = ~[/?#]*                          \n"
+    "path    = ~[?#]*                           \n"
+    "query   = ~'#'*                            \n"
+    "frag    = ~_WS*                            \n",
+    { "http://www.ics.uci.edu/pub/ietf/uri/?a=b#Related", NULL } },
+    { "kws",
+    "s  = (kw _)+                                  \n"
+    "kw = 'int' / 'in' / 'for'i / 'FOREACH' / 'é'   \n"
+    "_  = [ ]*                                     \n",
+    { "int in FOR For é FOREACH", NULL } },
+    { "opt",
+    "list  = _sp item (_sp ',' _sp item)* _sp   \n"
+    "item  = num / (_key / (word / '-'))        \n"
+    "num   = _dig+                              \n"
+    "word  = [a-z]+                             \n"
+    "_key  = 'nil' / 'any'                      \n"
+    "_dig  = [0-9]                              \n"
+    "_sp   = [ \\t]*                             \n",
+    { " 42, nil ,x, - ,any", NULL } },
+    { "back",
+    "s     = (a / b / date)+ !'x' &[]?   \n"
+    "a     = x 'a'                       \n"
+    "b     = x 'b'                       \n"
+    "x     = [0-9]+                      \n"
+    "date  = '(' d*4 '-' d*2..3 ')'      \n"
+    "d     = [0-9]                       \n",
+    { "12b34a5b(2022-123)6a", NULL } },
+};
+
+#ifdef GEN // a generated parser driver, built by the tests below
+
+#include GEN // the generated parser, it includes pPEG.c
+
+bool same_node(Node* x, Node* y) {
+    if (!x || !y) return x == y;
+    if (x->tag != y->tag || x->start != y->start || x->end != y->end) return false;
+    if (x->count != y->count) return false;
+    for (int i=0; i<x->count; i++) {
+        if (!same_node(x->nodes[i], y->nodes[i])) return false;
+    }
+    return true;
+}
+
+bool same_parse(Peg* x, Peg* y) { // the same tree, or the same error
+    if (!same_node(x->tree, y->tree)) return false;
+    if (!x->err || !y->err) return x->err == y->err;
+    Err* a = x->err;
+    Err* b = y->err;
+    return a->err == b->err && a->pos == b->pos && a->fail_rule == b->fail_rule &&
+        same_node(a->expected, b->expected);
+}
+
+int diff(GenTest* t, Peg* gen, Peg* peg, char* input) {
+    Peg* x = peg_parse(gen, input);
+    Peg* y = peg_parse(peg, input);
+    bool same = same_parse(x, y);
+    if (!same) printf("**** %s generated parser differs on: %s\n", t->name, input);
+    peg_free(x);
+    peg_free(y);
+    return !same;
+}
+
+int main(void) {
+    GenTest* t = &tests[GEN_TEST];
+    Peg* gen = GEN_PEG();
+    Peg* peg = peg_compile(t->grammar);
+    int parses = 0;
+    int fails = 0;
+    for (int memo=0; memo<2; memo++) {
+        if (memo) { // and the same with all the rules memoized
+            peg_memo(gen, NULL);
+            peg_memo(peg, NULL);
+        }
+        for (int k=0; t->inputs[k]; k++) {
+            char* in = t->inputs[k];
+            int len = strlen(in);
+            char* s = malloc(len+1);
+            fails += diff(t, gen, peg, in);
+            parses += 1;
+            for (int i=0; i<len; i++) {
+                memcpy(s, in, i); // drop byte i
+                strcpy(s+i, in+i+1);
+                fails += diff(t, gen, peg, s);
+                strcpy(s, in); // change byte i
+                s[i] = in[(i*7+3)%len];
+                fails += diff(t, gen, peg, s);
+                parses += 2;
+            }
+            free(s);
+        }
+    }
+    if (fails == 0) printf("%s: %d parses, the same as the parser machine\n", t->name, parses);
+    peg_free(peg);
+    peg_free(gen);
+    return fails > 0;
+}
+
+#else
+
+#include "../pPEG.h"
+
+int main(void) {
+    printf("Test generated C parsers ...\n");
+    char* cc = getenv("CC");
+    if (!cc) cc = "cc";
+    int n = sizeof(tests)/sizeof(GenTest);
+    for (int i=0; i<n; i++) {
+        char* name = tests[i].name;
+        char path[100], exe[100], cmd[500];
+        sprintf(path, "/tmp/pPEG-gen-%s.c", name);
+        sprintf(exe, "/tmp/pPEG-gen-%s", name);
+        Peg* peg = peg_compile(tests[i].grammar);
+        if (!peg_gen_c(peg, name, path)) {
+            printf("**** %s gen C failed\n", name);
+            continue;
+        }
+        peg_free(peg);
+        sprintf(cmd, "%s -I.. -DGEN='\"%s\"' -DGEN_TEST=%d -DGEN_PEG=%s_peg gen.c -o %s -lpthread",
+            cc, path, i, name, exe);
+        if (system(cmd) != 0) printf("**** %s generated parser does not compile\n", name);
+        else {
+            fflush(stdout);
+            if (system(exe) != 0) printf("**** %s generated parser failed\n", name);
+        }
+        remove(path);
+        remove(exe);
+    }
+    printf("OK, gen tests done...\n");
+}
+
+#endif
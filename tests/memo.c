@@ -0,0 +1,94 @@
+#include "test-kit.c"
+#include <time.h>
+
+double nested_memo(int depth, char* input) { // best parse time, all memoized
+    char grammar[64*300];
+    int n = sprintf(grammar, "S = R1 'x' / R1 \n"); // R1 is a memo hit
+    for (int i=1; i<=depth; i++) n += sprintf(grammar+n, "R%d = R%d ';'? \n", i, i+1);
+    sprintf(grammar+n, "R%d = I+ \n I = [0-9] \n", depth+1);
+    Peg* peg = peg_compile(grammar);
+    peg_memo(peg, NULL);
+    peg_memo_limit(peg, 1<<30);
+    double best = 1e9;
+    for (int i=0; i<10; i++) {
+        clock_t t = clock();
+        Peg* p = peg_parse(peg, input);
+        double time = (double)(clock()-t)/CLOCKS_PER_SEC;
+        if (peg_err(p)) peg_print(p);
+        peg_free(p);
+        if (time < best) best = time;
+    }
+    peg_free(peg);
+    return best;
+}
+
+int main(void) {
+    printf("Test packrat memo ...\n");
+
+    // X is re-parsed by each alternative, exponential without a memo..
+    char* s =
+    "S = X 'a' / X 'b' / X 'c'   \n"
+    "X = '(' S ')' / 'z'         \n";
+
+    Peg* peg = peg_compile(s);
+    if (!peg_memo(peg, "X")) {
+        printf("memo X failed....\n");
+        exit(1);
+    }
+    char input[1000];
+    int n = 0;
+    for (int i=0; i<100; i++) input[n++] = '(';
+    input[n++] = 'z';
+    for (int i=0; i<100; i++) {
+        input[n++] = 'c';
+        input[n++] = ')';
+    }
+    input[n++] = 'c';
+    input[n] = 0;
+    Peg* p = peg_parse(peg, input);
+    if (peg_err(p)) {
+        printf("parse error....\n");
+        peg_print(p);
+        exit(1);
+    }
+    printf("ok, nested 100 deep\n");
+    peg_free(p);
+
+    Peg* p1 = peg_parse(peg, "((zc)b)a");
+    peg_print(p1);
+    peg_free(p1);
+    printf("----\n");
+
+    // rules that match prior nodes can not be memoized..
+    char* r =
+    "str = tag raw tag  \n"
+    "raw = ~@tag*       \n"
+    "tag = '#'+         \n";
+
+    Peg* peg1 = peg_compile(r);
+    if (peg_memo(peg1, "raw")) printf("memo raw should fail....\n");
+    peg_memo(peg1, NULL);
+    Peg* p2 = peg_parse(peg1, "###abc##def###");
+    peg_print(p2);
+    peg_free(p2);
+    peg_free(peg1);
+    printf("----\n");
+
+    // a memo that is too small is ignored..
+    peg_memo_limit(peg, 100);
+    Peg* p3 = peg_parse(peg, "((zc)b)a");
+    peg_print(p3);
+    peg_free(p3);
+    peg_free(peg);
+    printf("----\n");
+
+    // nested memo rules share the result nodes, not a copy at each depth..
+    static char digits[20001];
+    for (int i=0; i<20000; i++) digits[i] = '0'+i%10;
+    double t1 = nested_memo(1, digits);
+    double t256 = nested_memo(256, digits);
+    if (t256 > 8*t1) printf("**** memo cost %.1fx for 256 nested rules\n", t256/t1);
+    else printf("ok, nested memo rules\n");
+
+    return 0;
+}
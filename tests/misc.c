@@ -1,4 +1,6 @@
 #include "test-kit.c"
+#include <string.h>
+#include <unistd.h>
 
 int main(void) {
     printf("Test pPEG misc ...\n");
@@ -14,6 +16,233 @@ int main(void) {
     "day   = [0-9]*2                  \n";
     test_trace(date, "2022-03-04");
 
+    // wide lists, many more sibling nodes than the initial results stack..
+    char* list =
+    "list  = '[' item (',' item)* ']'  \n"
+    "item  = [0-9]+                    \n";
+    char wide[40000];
+    int n = 0;
+    wide[n++] = '[';
+    for (int i=0; i<5000; i++) n += sprintf(wide+n, i? ",%d" : "%d", i);
+    wide[n++] = ']';
+    wide[n] = 0;
+    test_ok(list, wide);
+
+    // spans, repeats of char sets scanned many bytes at a time..
+    char* uri =
+    "uri   = path ('?' query)?         \n"
+    "path  = ~[?#]+                    \n"
+    "query = [a-z=&]*1..40             \n";
+    test_show(uri, "/a/long/path/to/a/file/with/«ünïcödé»/chars/and/more/path.txt?a=b&c=d");
+
+    // literals matched with a trie, the first alternative still wins..
+    char* kws =
+    "s  = (kw _)+                                  \n"
+    "kw = 'int' / 'in' / 'for'i / 'FOREACH' / 'é'   \n"
+    "_  = [ ]*                                     \n";
+    test_show(kws, "int in FOR For é");
+
+    // a trie for many more keywords than a first byte dispatch can take..
+    char* sql[] = { "SELECT", "FROM", "WHERE", "GROUP", "BY", "ORDER", "HAVING",
+        "LIMIT", "OFFSET", "UNION", "ALL", "DISTINCT", "AS", "ON", "JOIN", "LEFT",
+        "RIGHT", "INNER", "OUTER", "CROSS", "INTO", "IN", "INSERT", "VALUES",
+        "UPDATE", "SET", "DELETE", "CREATE", "TABLE", "INDEX", "VIEW", "DROP",
+        "ALTER", "ADD", "COLUMN", "PRIMARY", "KEY", "FOREIGN", "NOT", "NULL",
+        "AND", "OR", "LIKE", "BETWEEN", "EXISTS", "CASE", "WHEN", "THEN", "ELSE",
+        "END", NULL };
+    char sql_kws[1000];
+    n = sprintf(sql_kws, "s = (kw rest _)+ \n rest = [a-zA-Z]* \n _ = [ ]* \n kw = ");
+    for (int i=0; sql[i]; i++) n += sprintf(sql_kws+n, i? " / '%s'i" : "'%s'i", sql[i]);
+    sprintf(sql_kws+n, " \n");
+    Peg* sg = peg_compile(sql_kws);
+    char* debug_path = "/tmp/pPEG-misc-debug.txt";
+    fflush(stdout);
+    int out = dup(1); // the instruction trace to a file, to check for a TRIE
+    FILE* f = fopen(debug_path, "w");
+    dup2(fileno(f), 1);
+    Peg* sp = peg_debug(sg, "INTO");
+    fflush(stdout);
+    dup2(out, 1);
+    close(out);
+    fclose(f);
+    peg_free(sp);
+    char trace[20000];
+    f = fopen(debug_path, "r");
+    int len = f? fread(trace, 1, sizeof(trace)-1, f) : 0;
+    if (f) fclose(f);
+    trace[len] = 0;
+    remove(debug_path);
+    if (!strstr(trace, "TRIE")) printf("**** no trie for the SQL keywords\n");
+    sp = peg_parse(sg, "select INTO insert end"); // INTO before IN, IN before INSERT
+    peg_print(sp);
+    PegSpan into = peg_span(sp, peg_nodes(peg_tree(sp), 2));
+    PegSpan in = peg_span(sp, peg_nodes(peg_tree(sp), 4));
+    if (peg_err(sp) || into.len != 4 || in.len != 2) {
+        printf("**** keyword trie, the first alternative should win\n");
+    }
+    peg_free(sp);
+    peg_free(sg);
+
+    // a first byte dispatch with 31 alternatives, the most it is used for..
+    char wide_alt[400];
+    n = sprintf(wide_alt, "s = k+ \n d = [0-9]* \n k = 'A' d");
+    for (int i=1; i<31; i++) n += sprintf(wide_alt+n, " / '%c' d", i < 26? 'A'+i : 'a'+i-26);
+    sprintf(wide_alt+n, " \n");
+    test_show(wide_alt, "Ab1Z23eM");
+
+    // inlined _xyz rules, nested alternatives, an unreachable rule..
+    char* opt =
+    "list  = _sp item (_sp ',' _sp item)* _sp   \n"
+    "item  = num / (_key / (word / '-'))        \n"
+    "num   = _dig+                              \n"
+    "word  = [a-z]+                             \n"
+    "_key  = 'nil' / 'any'                      \n"
+    "_dig  = [0-9]                              \n"
+    "_sp   = [ \\t]*                             \n"
+    "other = word _sp                           \n";
+    test_show(opt, " 42, nil ,x, - ");
+
+    // an undefined rule is a grammar error, even if it is never used..
+    char* undef =
+    "s = x / y   \n"
+    "x = 'x'     \n";
+    Peg* bad = peg_compile(undef);
+    if (!peg_err(bad)) printf("**** expected undefined rule y\n");
+    peg_print(bad);
+    peg_free(bad);
+
+    // a compiled grammar saved, and loaded with no compile..
+    char* code_path = "/tmp/pPEG-misc-code.bin";
+    Peg* kg = peg_compile(kws);
+    if (!peg_save_compiled(kg, code_path)) printf("**** save compiled failed\n");
+    peg_free(kg);
+    Peg* lg = peg_load_compiled(code_path, kws);
+    if (!lg) printf("**** load compiled failed\n");
+    else {
+        Peg* lp = peg_parse(lg, "int in FOR For é");
+        peg_print(lp);
+        peg_free(lp);
+        lp = peg_parse(lg, "x");
+        peg_print(lp);
+        peg_free(lp);
+        peg_free(lg);
+    }
+    if (peg_load_compiled(code_path, opt)) printf("**** loaded for another grammar\n");
+    char span_text[300]; // a grammar span in a larger text
+    sprintf(span_text, "--%s--", kws);
+    kg = peg_compile_text(span_text, 2, 2+strlen(kws));
+    if (!peg_save_compiled(kg, code_path)) printf("**** save compiled span failed\n");
+    peg_free(kg);
+    lg = peg_load_compiled(code_path, span_text);
+    Peg* lp = lg? peg_parse(lg, "int in") : NULL;
+    if (!lp || peg_err(lp)) printf("**** load compiled span failed\n");
+    peg_free(lp);
+    peg_free(lg);
+    span_text[3] = '!';
+    if (peg_load_compiled(code_path, span_text)) printf("**** loaded for another grammar span\n");
+    remove(code_path);
+
+    // a flat tree prints the same as the Node tree..
+    Peg* dg = peg_compile(date);
+    Peg* dp = peg_parse(dg, "2022-03-04");
+    peg_print(dp);
+    Node* month = peg_nodes(peg_tree(dp), 1);
+    PegSpan text = peg_span(dp, month);
+    PegSpan name = peg_name_span(dp, month);
+    printf("%.*s %.*s %d..%d\n", (int)name.len, name.ptr, (int)text.len, text.ptr,
+        (int)peg_start(month), (int)peg_end(month));
+    char* tree_path = "/tmp/pPEG-misc-tree.bin";
+    if (!peg_save_tree(dp, tree_path)) printf("**** save tree failed\n");
+    Peg* saved = peg_load_tree(dg, tree_path, "2022-03-04");
+    if (!saved) printf("**** load tree failed\n");
+    else peg_print(saved);
+    peg_free(saved);
+    if (peg_load_tree(dg, tree_path, "2022-03-05")) printf("**** loaded with another input\n");
+    remove(tree_path);
+    int count = 0;
+    PegFlat* flat = peg_flat(dp, &count);
+    if (count != 4 || flat[0].size != 4 || flat[1].size != 1 || peg_tree(dp)) {
+        printf("**** flat tree count %d\n", count);
+    }
+    peg_print(dp);
+    peg_free(dp);
+    peg_free(dg);
+
+    // a file parsed in place, a page of input with no 0 end..
+    char* path = "/tmp/pPEG-misc-file.txt";
+    f = fopen(path, "wb");
+    for (int i=0; i<4095; i++) fputc(i%64 == 63? '\n' : 'a', f);
+    fputc('b', f);
+    fclose(f);
+    Peg* lines = peg_compile("s = ([a]+ '\n')*");
+    Peg* fp = peg_parse_file(lines, path);
+    peg_print(fp); // fell short at 4095
+    peg_free(fp);
+    if (peg_parse_file(lines, "/tmp/pPEG-no-such-file")) printf("**** expected no file\n");
+    peg_free(lines);
+    remove(path);
+
+    // a C parser generated for a grammar (built and run by tools/peg-gen.c)..
+    char* gen_path = "/tmp/pPEG-misc-gen.c";
+    Peg* gg = peg_compile(kws);
+    if (!peg_gen_c(gg, "kws", gen_path)) printf("**** gen C failed\n");
+    if (peg_gen_c(gg, "2kws", gen_path)) printf("**** gen C with a bad name\n");
+    char line[200];
+    bool found = false;
+    f = fopen(gen_path, "r");
+    while (f && fgets(line, sizeof(line), f)) {
+        if (strcmp(line, "Peg* kws_peg(void) {\n") == 0) found = true;
+    }
+    if (f) fclose(f);
+    if (!found) printf("**** gen C has no kws_peg\n");
+    peg_free(gg);
+    remove(gen_path);
+
+    // rule profile counters, a rule that fails and drops its x nodes..
+    char* back =
+    "s = (a / b)+   \n"
+    "a = x 'a'      \n"
+    "b = x 'b'      \n"
+    "x = [0-9]+     \n";
+    Peg* pg = peg_compile(back);
+    int rules = 0;
+    PegProfile* prof = peg_profile(pg, &rules);
+    Peg* pp = peg_parse(pg, "12b34a5b");
+    peg_profile_print(pg);
+    if (rules != 4 || prof[1].fails != 2 || prof[3].dropped != 2) {
+        printf("**** profile a fails %lld, x dropped %lld\n", prof[1].fails, prof[3].dropped);
+    }
+    peg_free(pp);
+    peg_free(pg);
+
+    // rescan heatmap, the x digits are scanned again when rule a fails..
+    char* heat_path = "/tmp/pPEG-misc-heat.txt";
+    Peg* hg = peg_compile(back);
+    fflush(stdout);
+    out = dup(1); // the report to a file, to check it
+    f = fopen(heat_path, "w");
+    dup2(fileno(f), 1);
+    Peg* hp = peg_heatmap(hg, "123b34a56789b", 4);
+    fflush(stdout);
+    dup2(out, 1);
+    close(out);
+    fclose(f);
+    if (peg_err(hp)) printf("**** heatmap parse failed\n");
+    peg_free(hp);
+    peg_free(hg);
+    char report[2000];
+    f = fopen(heat_path, "r");
+    len = f? fread(report, 1, sizeof(report)-1, f) : 0;
+    if (f) fclose(f);
+    report[len] = 0;
+    printf("%s", report);
+    if (!strstr(report, "rescans: 3 in 3 of 4 buckets of 4 bytes\n") ||
+        !strstr(report, "1 rescans of 0..4 on line: 1.1\n123b34a56789b\n^\n           1  s a\n") ||
+        !strstr(report, "1 rescans of 8..12 on line: 1.9\n")) {
+        printf("**** heatmap report\n");
+    }
+    remove(heat_path);
+
     printf("OK, misc tests done...\n");
 }
 
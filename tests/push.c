@@ -0,0 +1,101 @@
+#include <string.h>
+#include "test-kit.c"
+
+Peg* push_parse(Peg* peg, char* input, int chunk) { // feed chunk bytes at a time
+    PegFeed* ctx = peg_push(peg);
+    int len = strlen(input);
+    for (int i=0; i<len; i+=chunk) {
+        peg_feed(ctx, input+i, len-i < chunk? len-i : chunk);
+    }
+    return peg_finish(ctx);
+}
+
+bool same_node(Node* x, Node* y) { // the same tags, spans and children
+    if (!x || !y) return x == y;
+    if (peg_tag(x) != peg_tag(y) || peg_start(x) != peg_start(y) || peg_end(x) != peg_end(y)) {
+        return false;
+    }
+    if (peg_count(x) != peg_count(y)) return false;
+    for (int i=0; i<peg_count(x); i++) {
+        if (!same_node(peg_nodes(x, i), peg_nodes(y, i))) return false;
+    }
+    return true;
+}
+
+int main(void) {
+    printf("Test push parser ...\n");
+
+    char* json =
+    "json   = _ value _                          \n"
+    "value  = Str / Arr / Obj / num / lit        \n"
+    "Obj    = '{'_ (memb (_','_ memb)*)? _'}'    \n"
+    "memb   = Str _':'_ value                    \n"
+    "Arr    = '['_ (value (_','_ value)*)? _']'  \n"
+    "Str    = _DQ chars* _DQ                     \n"
+    "chars  = ~(_0-1F/_BS/_DQ)+ / _BS [\"/bnrt]  \n"
+    "num    = '-'? [0-9]+ ('.' [0-9]+)?          \n"
+    "lit    = 'true' / 'false' / 'null'          \n";
+
+    Peg* peg = peg_compile(json);
+    char* doc = "{ \"a\": [1, 2.5, \"x\\\"y\", true, null], \"«é»\": {} }";
+
+    // the same tree for any chunk size..
+    Peg* p = peg_parse(peg, doc);
+    peg_print(p);
+    for (int chunk=1; chunk<8; chunk++) {
+        Peg* q = push_parse(peg, doc, chunk);
+        if (peg_err(q) || !same_node(peg_tree(q), peg_tree(p))) {
+            printf("**** push parse chunk %d failed\n", chunk);
+            peg_print(q);
+        }
+        peg_free(q);
+    }
+    peg_free(p);
+
+    // the parse is over before all the input has been fed..
+    PegFeed* ctx = peg_push(peg);
+    bool more = peg_feed(ctx, "[1, 2", 5);
+    if (!more) printf("**** expected more input\n");
+    more = peg_feed(ctx, "] x", 3);
+    if (more) printf("**** expected the parse to end\n");
+    Peg* short_p = peg_finish(ctx);
+    peg_print(short_p); // fell short
+    peg_free(short_p);
+
+    Peg* bad = push_parse(peg, "[1, tru]", 2);
+    peg_print(bad);
+    peg_free(bad);
+
+    // a long string fed in small chunks, the span goes on from each end..
+    int big = 1 << 20;
+    char* long_str = malloc(big+3);
+    long_str[0] = '"';
+    for (int i=1; i<=big; i++) long_str[i] = 'a'+i%26;
+    long_str[big+1] = '"';
+    long_str[big+2] = 0;
+    Peg* lp = push_parse(peg, long_str, 16);
+    Node* chars = peg_err(lp)? NULL : peg_nodes(peg_tree(lp), 0);
+    if (!chars || peg_end(chars)-peg_start(chars) != big) {
+        printf("**** push parse of a long string failed\n");
+    }
+    peg_free(lp);
+    free(long_str);
+
+    // a counted span, with a UTF-8 char split over chunks..
+    Peg* counted = peg_compile("s = w d  w = [a-zé]*3..6  d = [0-9]*");
+    p = peg_parse(counted, "aébcé12");
+    for (int chunk=1; chunk<4; chunk++) {
+        Peg* q = push_parse(counted, "aébcé12", chunk);
+        if (peg_err(q) || !same_node(peg_tree(q), peg_tree(p))) {
+            printf("**** push parse counted span chunk %d failed\n", chunk);
+            peg_print(q);
+        }
+        peg_free(q);
+    }
+    peg_print(p);
+    peg_free(p);
+    peg_free(counted);
+
+    peg_free(peg);
+    printf("OK, push tests done...\n");
+}
@@ -44,7 +44,7 @@ char* read_file(char* path) {
         fseek(f, 0, SEEK_END);
         len = ftell(f);
         fseek(f, 0, SEEK_SET);
-        buf = malloc(len);
+        buf = malloc(len+1);
         if (buf) {
             fread(buf, 1, len, f);
         }
@@ -18,6 +18,8 @@ void test_ok(char* grammar, char* input) {
         peg_print(p);
         exit(1);
     }
+    peg_free(p);
+    peg_free(peg);
 }
 
 void test_show(char* grammar, char* input) {
@@ -30,6 +32,8 @@ void test_show(char* grammar, char* input) {
     Peg* p = peg_parse(peg, input);
     peg_print(p); // AST input result
     printf("----\n");
+    peg_free(p);
+    peg_free(peg);
 }
 
 void test_verbose(char* grammar, char* input) {
@@ -39,6 +43,8 @@ void test_verbose(char* grammar, char* input) {
     Peg* p = peg_parse(peg, input);
     peg_print(p); // AST for an input
     printf("----\n");
+    peg_free(p);
+    peg_free(peg);
 }
 
 void test_trace(char* grammar, char* input) {
@@ -54,6 +60,8 @@ void test_trace(char* grammar, char* input) {
         peg_print(p);
         exit(1);
     }
+    peg_free(p);
+    peg_free(peg);
 }
 
 // int main(void) {
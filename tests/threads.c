@@ -0,0 +1,93 @@
+#include <string.h>
+#include <pthread.h>
+
+#include "test-kit.c"
+
+// cc -o threads threads.c ../pPEG.c -lpthread
+
+#define THREADS 8
+#define RUNS 100
+
+char* json_grammar =
+"    json   = _ value _                                  \n"
+"    value  =  Str / Arr / Obj / num / lit               \n"
+"    Obj    = '{'_ (memb (_','_ memb)*)? _'}'            \n"
+"    memb   = Str _':'_ value                            \n"
+"    Arr    = '['_ (value (_','_ value)*)? _']'          \n"
+"    Str    = _DQ chars* _DQ                             \n"
+"    chars  = ~(_0-1F/_BS/_DQ)+ / _BS esc                \n"
+"    esc    = [/bfnrt] / _DQ / _BS 'u' [0-9a-fA-F]*4     \n"
+"    num    = _int _frac? _exp?                          \n"
+"    _int   = '-'? ([1-9] [0-9]* / '0')                  \n"
+"    _frac  = '.' [0-9]+                                 \n"
+"    _exp   = [eE] [+-]? [0-9]+                          \n"
+"    lit    = 'true' / 'false' / 'null'                  \n";
+
+Peg* json;     // shared by all the threads
+Peg* owns[THREADS];
+char input[20000];
+long results[THREADS];
+
+int count_nodes(Node* node) {
+    int n = 1;
+    for (int i=0; i<peg_count(node); i++) n += count_nodes(peg_nodes(node, i));
+    return n;
+}
+
+void* compiler(void* arg) { // compiles at once share the static boot tables
+    Peg** own = arg;
+    *own = peg_compile(json_grammar);
+    return NULL;
+}
+
+void* worker(void* arg) {
+    long* result = arg;
+    Peg* own = owns[result-results];
+    long total = 0;
+    for (int i=0; i<RUNS; i++) {
+        Peg* p = peg_parse(i%2? json : own, input);
+        if (peg_err(p)) {
+            total = -1;
+            break;
+        }
+        total += count_nodes(peg_tree(p));
+        peg_free(p);
+    }
+    peg_free(own);
+    *result = total;
+    return NULL;
+}
+
+int main(void) {
+    printf("Test pPEG threads sharing a grammar ...\n");
+
+    int n = 0;
+    input[n++] = '[';
+    for (int i=0; i<200; i++) {
+        n += sprintf(input+n, "%s{\"id\": %d, \"ok\": [true, null, 1.5e3]}", i? ", " : "", i);
+    }
+    input[n++] = ']';
+    input[n] = 0;
+
+    pthread_t threads[THREADS];
+    for (int i=0; i<THREADS; i++) {
+        pthread_create(&threads[i], NULL, compiler, &owns[i]);
+    }
+    for (int i=0; i<THREADS; i++) pthread_join(threads[i], NULL);
+
+    json = peg_compile(json_grammar);
+    for (int i=0; i<THREADS; i++) {
+        pthread_create(&threads[i], NULL, worker, &results[i]);
+    }
+    for (int i=0; i<THREADS; i++) pthread_join(threads[i], NULL);
+
+    Peg* p = peg_parse(json, input);
+    long expect = RUNS*(long)count_nodes(peg_tree(p));
+    for (int i=0; i<THREADS; i++) {
+        if (results[i] != expect) {
+            printf("**** thread %d: %ld nodes, expected %ld\n", i, results[i], expect);
+            exit(1);
+        }
+    }
+    printf("OK, %d threads x %d parses\n", THREADS, RUNS);
+}
@@ -41,6 +41,23 @@ int main(void) {
     test_ok(s9, "\n");
     test_ok(s9, "  \t\r\r\n   ");
 
+    // char sets, ranges and negated sets....
+
+    char* s10 = "s10 = [a-zα-ω€😀]+ \n";
+    test_ok(s10, "aω€😀z");
+
+    char* s11 = "s11 = ~(_3B1-3C9 / [x-z] / '😀')+ \n";
+    test_ok(s11, "a«€中ab");
+
+    char* s12 = "s12 = _4E00-9FFF+ \n"; // 3 byte chars
+    test_ok(s12, "中文字");
+
+    // case insensitive literals, Unicode case folds....
+
+    char* s13 = "s13 = ('straße'i / 'Ωμέγα'i / 'привет'i / 'x'i / 'é'i)+ \n";
+    test_ok(s13, "STRAßEωμέγαПРИВЕТXÉé");
+    test_ok(s13, "ΩΜΈΓΑПриВет");
+
     printf("OK, UTF-8 tests done...\n");
 }
 
@@ -0,0 +1,80 @@
+#define PEG_BOOT_GEN
+#include "../pPEG.c"
+
+// Generate pPEG-boot.h, the BOOT grammar as static tables, from boot_code():
+//
+//   > cc tools/boot-gen.c -o boot-gen -lpthread
+//   > ./boot-gen > pPEG-boot.h
+//
+// run it again after a change to peg_grammar, boot_code, or the compiler.
+
+void print_ints(char* name, int* xs, int n) {
+    printf("static const int %s[] = {", name);
+    for (int i=0; i<n; i++) printf("%s%d,", i%16? " " : "\n    ", xs[i]);
+    printf("\n};\n\n");
+}
+
+void print_chars(char* name, char* xs, int n) {
+    printf("static const char %s[] = {", name);
+    for (int i=0; i<n; i++) printf("%s%d,", i%16? " " : "\n    ", xs[i]);
+    printf("\n};\n\n");
+}
+
+void print_node(NodeIndex* nodes, int n, Node* nd) { // children first
+    for (int i=0; i<nd->count; i++) print_node(nodes, n, nd->nodes[i]);
+    int k = node_index(nodes, n, nd);
+    if (nd->count == 0) printf("static const Node boot_n%d = ", k);
+    else printf("static const BOOT_NODE(%d) boot_n%d = ", nd->count, k);
+    printf("{ %lld, %lld, %d, %d, 0, %d, {{ %d, %d, %d, %d, %d, %d, %d }}",
+        (long long)nd->start, (long long)nd->end, nd->tag, nd->data_use, nd->count,
+        nd->data.opx.idx, nd->data.opx.min, nd->data.opx.max, nd->data.opx.sign,
+        nd->data.opx.builtin, nd->data.opx.is_multi, nd->data.opx.multi);
+    if (nd->count > 0) {
+        printf(",\n    {");
+        for (int i=0; i<nd->count; i++) {
+            printf("%s(Node*)&boot_n%d", i? ", " : " ", node_index(nodes, n, nd->nodes[i]));
+        }
+        printf(" }");
+    }
+    printf(" };\n");
+}
+
+int main(void) {
+    pthread_once(&boot_once, bootstrap);
+    Peg* peg = BOOT;
+    Code* code = peg->code;
+    int n = flat_size(peg->tree);
+    NodeIndex* nodes = node_indexes(peg->tree, n);
+
+    printf("// The BOOT grammar: the peg_grammar ptree and its compiled code,\n");
+    printf("// generated by tools/boot-gen.c from boot_code(), do not edit.\n\n");
+    printf("#define BOOT_NODE(n) struct { peg_pos start; peg_pos end; short int tag; \\\n");
+    printf("    char data_use; char memo; int count; Slot data; Node* nodes[n]; }\n\n");
+    print_node(nodes, n, peg->tree);
+    printf("\nstatic Node* const boot_exps[] = {");
+    for (int i=0; i<code->exp_count; i++) {
+        if (!code->exps[i]) printf("%sNULL,", i%6? " " : "\n    ");
+        else printf("%s(Node*)&boot_n%d,", i%6? " " : "\n    ",
+            node_index(nodes, n, code->exps[i]));
+    }
+    printf("\n};\n\n");
+    print_ints("boot_ops", code->ops, code->len);
+    print_ints("boot_fail", code->fail, code->len);
+    print_ints("boot_note", code->note, code->len);
+    print_ints("boot_exp_rule", code->exp_rule, code->exp_count);
+    print_ints("boot_entry", code->entry, code->rule_count);
+    print_chars("boot_mode", code->mode, code->rule_count);
+    print_chars("boot_memo", code->memo, code->rule_count);
+    printf("static const Code boot_code_tables = {\n");
+    printf("    (int*)boot_ops, %d, (int*)boot_fail, (int*)boot_note,\n", code->len);
+    printf("    (Node**)boot_exps, (int*)boot_exp_rule, %d,\n", code->exp_count);
+    printf("    (int*)boot_entry, (char*)boot_mode, %d, (char*)boot_memo,\n", code->rule_count);
+    if (code->memo_limit == MEMO_LIMIT) printf("    MEMO_LIMIT,");
+    else printf("    %d,", code->memo_limit);
+    printf(" %s, NULL, 0, NULL, NULL\n};\n\n", code->dispatch? "true" : "false");
+    printf("static const Peg boot_peg = {\n");
+    printf("    peg_grammar, (Node*)&boot_n0, NULL, NULL, (Code*)&boot_code_tables,\n");
+    printf("    NULL, NULL, 0, NULL, 0, false\n};\n");
+    free(nodes);
+    return 0;
+}
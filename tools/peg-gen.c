@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../pPEG.h"
+
+// Generate a C parser for a grammar file (peg_gen_c):
+//
+//   > cc -O2 tools/peg-gen.c pPEG.c -o peg-gen -lpthread
+//   > ./peg-gen json.peg json json-parser.c
+//   > cc -O2 -I. app.c json-parser.c -o app -lpthread
+//
+// the generated file includes pPEG.c (it is compiled instead of pPEG.c),
+// the app calls json_peg() for the grammar, then peg_parse as usual.
+
+char* read_file(char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* s = malloc(len+1);
+    if (s && fread(s, 1, len, f) != (size_t)len) {
+        free(s);
+        s = NULL;
+    }
+    if (s) s[len] = 0;
+    fclose(f);
+    return s;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        printf("usage: peg-gen grammar.peg name out.c\n");
+        return 2;
+    }
+    char* grammar = read_file(argv[1]);
+    if (!grammar) {
+        printf("can not read: %s\n", argv[1]);
+        return 1;
+    }
+    Peg* peg = peg_compile(grammar);
+    if (peg_err(peg)) {
+        peg_print(peg);
+        return 1;
+    }
+    if (!peg_gen_c(peg, argv[2], argv[3])) {
+        printf("can not generate %s as: %s\n", argv[2], argv[3]);
+        return 1;
+    }
+    return 0;
+}